@@ -3,6 +3,10 @@
 #include <cstdint>      // (u)int_XX_t
 #include <algorithm>    // copy find_if for_each (limits:numeric_limits)
 #include <cstddef>      // size_t
+#include <cstdlib>      // strtod strtoll strtoull
+#include <cstring>      // strchr
+#include <cerrno>       // errno
+#include <cmath>        // frexp ldexp
 #include <iostream>
 #include <sstream>      // basic_ostringstream
 #include <set>
@@ -10,10 +14,27 @@
 #include <string>
 #include <tuple>
 #include <forward_list>
+#include <vector>
 #include <utility>
-#include <iomanip>      // setfill, setw
 #include <iterator>     // begin, end
 #include <type_traits>  // true_type, false_type
+#include <limits>       // numeric_limits
+#include <locale>       // locale::classic
+#include <future>       // async, future
+#include <thread>       // thread::hardware_concurrency
+#if (__cplusplus >= 201703L)
+#include <charconv>     // to_chars
+#endif
+#if (__cplusplus > 201703L)
+#include <ranges>       // input_range, view
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>  // _mm256_*
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>  // _mm_shuffle_epi8, _mm_alignr_epi8
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>  // _mm_*
+#endif
 
 #if (__cplusplus < 201103L)
 #error "container_stream_io only supports C++11 and above"
@@ -276,6 +297,43 @@ template <typename Type>
 constexpr bool is_parseable_as_container_v = is_parseable_as_container<Type>::value;
 
 #endif
+/**
+ * @brief tests for "iterable" classes, with members iterator, begin(), end(),
+ *   and empty()
+ * @notes default overload of is_printable_as_container repeats these
+ *   requirements, as deriving it from is_iterable makes it ambiguous with the
+ *   std::basic_string(_view) exclusions
+ */
+template <typename Type, typename = void>
+struct is_iterable : public std::false_type
+{};
+
+template <typename Type>
+struct is_iterable<
+    Type, std::void_t<typename Type::iterator,
+                      decltype(std::declval<Type&>().begin()),
+                      decltype(std::declval<Type&>().end()),
+                      decltype(std::declval<Type&>().empty())>>
+    : public std::true_type
+{};
+
+#ifdef __cpp_lib_ranges
+/**
+ * @brief tests for C++20 input ranges that are not iterable (eg
+ *   std::views::transform, which lacks member iterator), and that can be
+ *   iterated from a const reference, either directly or through a copy in the
+ *   case of views (eg std::views::filter, which is only iterable when non-const)
+ */
+template <typename Type>
+struct is_printable_as_range : public std::integral_constant<
+    bool,
+    std::ranges::input_range<Type> && !is_iterable<Type>::value &&
+    !std::is_array<Type>::value &&
+    (std::ranges::input_range<const Type> ||
+     (std::ranges::view<Type> && std::copy_constructible<Type>))>
+{};
+
+#endif  // __cpp_lib_ranges
 /**
  * @brief tests for class compatibility with container ostreaming
  * @notes overloads should behave as follows:
@@ -287,6 +345,8 @@ constexpr bool is_parseable_as_container_v = is_parseable_as_container<Type>::va
  *         std::(unordered_)(multi)set, std::(unordered_)(multi)map
  *       but not:
  *         std::stack, std::queue, std::priority_queue (lacking iterator, begin(), end())
+ *   - C++20 ranges: inclusion of views and other input ranges which are not
+ *       "iterable" (see is_printable_as_range)
  *   - std::pair: exeception to default
  *   - std::tuple: exeception to default
  *   - C array of non-char type: exeception to default
@@ -307,6 +367,15 @@ struct is_printable_as_container<
     : public std::true_type
 {};
 
+#ifdef __cpp_lib_ranges
+template <typename Type>
+struct is_printable_as_container<
+    Type, std::enable_if_t<is_printable_as_range<Type>::value, void>>
+    : public std::true_type
+{};
+
+#endif  // __cpp_lib_ranges
+
 template <typename FirstType, typename SecondType>
 struct is_printable_as_container<std::pair<FirstType, SecondType>> : public std::true_type
 {};
@@ -347,6 +416,45 @@ template <typename Type>
 constexpr bool is_printable_as_container_v = is_printable_as_container<Type>::value;
 
 #endif
+/**
+ * @brief tests for arithmetic types streamed as numbers, excluding bool and
+ *   char types, and also signed/unsigned char, which are streamed as chars
+ */
+template <typename Type>
+struct is_numeric_type : public std::integral_constant<
+    bool,
+    std::is_arithmetic<Type>::value && !is_char_type<Type>::value &&
+    !std::is_same<Type, bool>::value && (sizeof(Type) > 1)>
+{};
+
+/**
+ * @brief tests for containers storing numeric elements contiguously
+ * @notes overloads as follows:
+ *   - base case: all incompatible types excluded
+ *   - C array
+ *   - default: classes with members data() and size(), eg std::vector,
+ *       std::array
+ */
+template <typename Type, typename = void>
+struct is_contiguous_numeric_container : public std::false_type
+{};
+
+template <typename ElementType, std::size_t ArraySize>
+struct is_contiguous_numeric_container<ElementType[ArraySize]>
+    : public std::integral_constant<bool, is_numeric_type<ElementType>::value>
+{};
+
+template <typename Type>
+struct is_contiguous_numeric_container<
+    Type, std::void_t<decltype(std::declval<const Type&>().data()),
+                      decltype(std::declval<const Type&>().size())>>
+    : public std::integral_constant<
+    bool,
+    std::is_pointer<decltype(std::declval<const Type&>().data())>::value &&
+    is_numeric_type<typename std::remove_cv<typename std::remove_pointer<
+                        decltype(std::declval<const Type&>().data())>::type>::type>::value>
+{};
+
 /**
  * @brief helper function to determine if a container is empty
  */
@@ -365,8 +473,72 @@ constexpr bool is_empty(const ArrayType (&)[ArraySize]) noexcept
     return ArraySize == 0;
 }
 
+/**
+ * @brief helper functions to get pointer to first element and element count of
+ *   contiguous containers
+ * @notes overloads as follows:
+ *   - default: classes with members data() and size()
+ *   - C array
+ */
+template <typename ContainerType>
+auto contiguous_data(const ContainerType& container) noexcept
+    -> decltype(container.data())
+{
+    return container.data();
+}
+
+template <typename ArrayType, std::size_t ArraySize>
+constexpr const ArrayType* contiguous_data(const ArrayType (&array)[ArraySize]) noexcept
+{
+    return array;
+}
+
+template <typename ContainerType>
+auto contiguous_size(const ContainerType& container) noexcept
+    -> decltype(container.size())
+{
+    return container.size();
+}
+
+template <typename ArrayType, std::size_t ArraySize>
+constexpr std::size_t contiguous_size(const ArrayType (&)[ArraySize]) noexcept
+{
+    return ArraySize;
+}
+
 }  // namespace traits
 
+}  // namespace container_stream_io
+
+/**
+ * @brief forward declarations of container stream operators (defined at end of
+ *   file)
+ * @notes formatters stream nested containers with unqualified operator<</>>,
+ *   and ADL only searches the namespaces of the element type (eg std), so the
+ *   global overloads must already be visible at the point of formatter
+ *   definition
+ */
+template <typename ContainerType, typename StreamType>
+auto operator>>(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+    container_stream_io::traits::is_parseable_as_container<ContainerType>::value,
+    StreamType&>;
+
+template <typename ContainerType, typename StreamType>
+auto operator<<(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+    container_stream_io::traits::is_printable_as_container<ContainerType>::value,
+    StreamType&>;
+
+namespace container_stream_io {
+
+namespace memory {
+
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class basic_input_buffer;
+
+}  // namespace memory
+
 /**
  * @brief contains resources for string encoding/decoding
  */
@@ -571,8 +743,11 @@ namespace detail {
 
 /**
  * @brief labels for string representation type flag values
+ * @notes utf8 is a variant of literal, which passes well-formed UTF-8
+ *   multi-byte sequences through unescaped where both string and stream
+ *   char types are single byte, and otherwise encodes as literal
  */
-enum class repr_type { literal, quoted };
+enum class repr_type { literal, quoted, utf8 };
 
 /**
  * @brief stream index getter for use with iword/pword to set literalrepr/quotedrepr
@@ -583,6 +758,14 @@ static inline int get_manip_i()
     return i;
 }
 
+/**
+ * @brief gets repr set on stream with literalrepr/quotedrepr/utf8repr
+ */
+inline repr_type get_repr(std::ios_base& stream)
+{
+    return static_cast<repr_type>(stream.iword(get_manip_i()));
+}
+
 /**
  * @brief string representation, contains data necessary to istream/ostream a
  *   a quoted/literal string encoding
@@ -629,7 +812,7 @@ public:
                 const CharType esc, const repr_type typ) :
         string{str}, delim{dlm}, escape{esc}, type{typ}
     {
-        if (type == repr_type::literal &&
+        if (type != repr_type::quoted &&
             (dlm > 0x7f || !std::isprint(dlm) ||
              esc > 0x7f || !std::isprint(esc)))
             throw(std::invalid_argument(
@@ -670,6 +853,17 @@ std::map<CharType, CharType> string_repr<StringType, CharType>::ascii_escapes::b
     }
 };
 
+/**
+ * @brief copies a string representation with another repr type, eg to get a
+ *   utf8 representation from literal() with the same default delimiters
+ */
+template <typename StringType, typename CharType>
+string_repr<StringType, CharType> with_type(
+    const string_repr<StringType, CharType>& repr, const repr_type type)
+{
+    return { repr.string, repr.delim, repr.escape, type };
+}
+
 /**
  * @brief helper to operator<<(string_repr), ostreams literal prefix
  */
@@ -691,160 +885,665 @@ static void insert_literal_prefix(
 }
 
 /**
- * @brief helper to operator<<(string_repr), ostreams one character from a
- *   string representation
+ * @brief lowercase hex digits indexed by nibble value
  */
-template <typename StreamCharType, typename StringType, typename StringCharType>
-static void insert_escaped_char(
+static constexpr char hex_digits[] { "0123456789abcdef" };
+
+/**
+ * @brief helper to insert_escaped_char, ostreams a hex escape sequence with
+ *   the fixed width of 2 digits per byte of StringCharType
+ * @notes digits are written from the nibble table into a local buffer, rather
+ *   than with std::hex/setfill/setw and num_put, leaving stream flags as
+ *   they are
+ */
+template <typename StreamCharType, typename StringCharType>
+static void insert_hex_escape(
     std::basic_ostream<StreamCharType>& os,
-    const string_repr<StringType, StringCharType>& repr,
+    const StreamCharType escape,
     const StringCharType c)
 {
-    static constexpr uint32_t hex_mask {
-        (sizeof(StringCharType) == 1) ? 0xff :
-        (sizeof(StringCharType) == 2) ? 0xffff :
-                                        0xffffffff };
+    static constexpr std::size_t hex_length { sizeof(StringCharType) * 2 };
+    using value_type = typename std::make_unsigned<StringCharType>::type;
+
+    StreamCharType buff[hex_length + 2];
+    buff[0] = escape;
+    buff[1] = StreamCharType('x');
+    auto value { static_cast<std::uint_least32_t>(static_cast<value_type>(c)) };
+    for (std::size_t i { hex_length + 1 }; i > 1; --i, value >>= 4)
+        buff[i] = StreamCharType(hex_digits[value & 0xf]);
+    os.write(buff, hex_length + 2);
+}
 
-    if (c < 0x7f && std::isprint(c))
-    {
-        // literal_repr ctor enforces ASCII-printable delim and escape
-        if (c == repr.delim || c == repr.escape)
-            os << StreamCharType(repr.escape);
-        os << StreamCharType(c);
-    }
-    else
+/**
+ * @brief gets the length of a well-formed UTF-8 sequence from its lead byte,
+ *   or 0 for bytes which cannot lead a multi-byte sequence
+ */
+static constexpr std::size_t utf8_sequence_length(const unsigned char lead)
+{
+    return lead < 0xc2 ? 0 : lead < 0xe0 ? 2 : lead < 0xf0 ? 3 : lead < 0xf5 ? 4 : 0;
+}
+
+/**
+ * @brief validates the second byte of a UTF-8 sequence against its lead byte,
+ *   excluding overlong encodings, surrogates and values beyond U+10FFFF (see
+ *   Unicode table 3-7), with any further bytes being 0x80-0xbf
+ */
+static constexpr bool is_utf8_second_byte(const unsigned char lead,
+                                          const unsigned char byte)
+{
+    return lead == 0xe0 ? (byte >= 0xa0 && byte <= 0xbf) :
+           lead == 0xed ? (byte >= 0x80 && byte <= 0x9f) :
+           lead == 0xf0 ? (byte >= 0x90 && byte <= 0xbf) :
+           lead == 0xf4 ? (byte >= 0x80 && byte <= 0x8f) :
+                          (byte >= 0x80 && byte <= 0xbf);
+}
+
+/**
+ * @brief gets the length of the well-formed UTF-8 sequence at first, or 0 if
+ *   it is invalid or truncated by last
+ */
+template <typename CharType>
+static std::size_t utf8_sequence_at(const CharType* first, const CharType* last)
+{
+    const auto byte = [first](const std::size_t i) {
+        return static_cast<unsigned char>(first[i]);
+    };
+    const auto length { utf8_sequence_length(byte(0)) };
+    if (length == 0 || static_cast<std::size_t>(last - first) < length ||
+        !is_utf8_second_byte(byte(0), byte(1)))
+        return 0;
+    for (std::size_t i { 2 }; i < length; ++i)
     {
-        os << StreamCharType(repr.escape);
-        try {
-            os << StreamCharType(repr.escapes.by_value.at(c));
-        } catch (const std::out_of_range& /*oor_ex*/) {
-            // custom hex escape sequence
-            os << StreamCharType('x') <<
-                std::hex << std::setfill(StreamCharType('0')) <<
-                std::setw(2 * sizeof(StringCharType)) <<
-                (hex_mask & static_cast<uint32_t>(c));
-        }
+        if (byte(i) < 0x80 || byte(i) > 0xbf)
+            return 0;
     }
+    return length;
 }
 
-// TBD maybe throw exeception rather than set failbit on quoted char size failure?
 /**
- * @brief ostream operator for string representations
- * @notes overloads as follows:
- *   - default: handles (const) basic_string& and (const) basic_string_view&
- *      represenations (potentially also (const) (CharT&)[] if not decayed?)
- *   - single-char: handles (const) CharT& representations
- *   - C string: handles (const) CharT* representations
+ * @brief SSE2 tests of blocks of chars of a given size, used to find and
+ *   convert runs of 7-bit ASCII in bulk
+ * @notes
+ *   - width of 0 (the default, and without SSE2) leaves all chars to scalar
+ *       loops
+ *   - plain() tests chars as signed values, so that values beyond 7-bit ASCII
+ *       fail the lower bound
  */
-template<typename StreamCharType, typename StringType, typename StringCharType>
-auto operator<<(
-    std::basic_ostream<StreamCharType>& ostream,
-    const string_repr<StringType&, StringCharType>& repr
-    ) -> std::enable_if_t<
-    traits::is_stl_string_type<std::remove_const_t<StringType>>::value,
-    std::basic_ostream<StreamCharType>&>
+template <std::size_t CharSize>
+struct ascii_block
 {
-    if (repr.type == repr_type::quoted &&
-        sizeof(StreamCharType) < sizeof(StringCharType))
+    static constexpr std::ptrdiff_t width { 0 };
+
+    static bool plain(const void* /*block*/, const int /*delim*/,
+                      const int /*escape*/) noexcept
     {
-        ostream.setstate(std::ios_base::failbit);
-        return ostream;
+        return false;
     }
-    std::basic_ostringstream<StreamCharType> oss;
-    insert_literal_prefix<StreamCharType, StringCharType>(oss);
-    oss << StreamCharType(repr.delim);
-    if (repr.type == repr_type::quoted)
+};
+
+#if defined(__SSE2__) || defined(_M_X64)
+template <>
+struct ascii_block<1>
+{
+    static constexpr std::ptrdiff_t width { 16 };
+
+    static bool plain(const void* block, const int delim, const int escape) noexcept
     {
-        for (const auto c : repr.string)
-        {
-            if (c == repr.delim || c == repr.escape)
-                oss << StreamCharType(repr.escape);
-            oss << StreamCharType(c);
-        }
+        const auto chars { _mm_loadu_si128(static_cast<const __m128i*>(block)) };
+        const auto special { _mm_or_si128(
+            _mm_cmpeq_epi8(chars, _mm_set1_epi8(static_cast<char>(delim))),
+            _mm_cmpeq_epi8(chars, _mm_set1_epi8(static_cast<char>(escape)))) };
+        const auto printable { _mm_and_si128(
+            _mm_cmpgt_epi8(chars, _mm_set1_epi8(0x1f)),
+            _mm_cmplt_epi8(chars, _mm_set1_epi8(0x7f))) };
+        return _mm_movemask_epi8(_mm_andnot_si128(special, printable)) == 0xffff;
     }
-    else
+};
+
+template <>
+struct ascii_block<2>
+{
+    static constexpr std::ptrdiff_t width { 8 };
+
+    static bool plain(const void* block, const int delim, const int escape) noexcept
     {
-        for (const auto c : repr.string)
-            insert_escaped_char(oss, repr, c);
+        const auto chars { _mm_loadu_si128(static_cast<const __m128i*>(block)) };
+        const auto special { _mm_or_si128(
+            _mm_cmpeq_epi16(chars, _mm_set1_epi16(static_cast<short>(delim))),
+            _mm_cmpeq_epi16(chars, _mm_set1_epi16(static_cast<short>(escape)))) };
+        const auto printable { _mm_and_si128(
+            _mm_cmpgt_epi16(chars, _mm_set1_epi16(0x1f)),
+            _mm_cmplt_epi16(chars, _mm_set1_epi16(0x7f))) };
+        return _mm_movemask_epi8(_mm_andnot_si128(special, printable)) == 0xffff;
     }
-    oss << StreamCharType(repr.delim);
-    return ostream << oss.str();
-}
 
-template <typename StreamCharType, typename CharType, typename StringCharType>
-auto operator<<(
-    std::basic_ostream<StreamCharType>& ostream,
-    const string_repr<CharType&, StringCharType>& repr
-    ) -> std::enable_if_t<
-    std::is_same<StringCharType, std::remove_const_t<CharType>>::value,
-    std::basic_ostream<StreamCharType>&>
-{
-    if (repr.type == repr_type::quoted &&
-        sizeof(StreamCharType) < sizeof(StringCharType))
+    // narrows chars known to be 7-bit ASCII
+    static void narrow(const void* block, void* out) noexcept
     {
-        ostream.setstate(std::ios_base::failbit);
-        return ostream;
+        const auto* in { static_cast<const __m128i*>(block) };
+        _mm_storeu_si128(static_cast<__m128i*>(out), _mm_packus_epi16(
+            _mm_loadu_si128(in), _mm_loadu_si128(in + 1)));
     }
-    std::basic_ostringstream<StreamCharType> oss;
-    insert_literal_prefix<StreamCharType, StringCharType>(oss);
-    oss << StreamCharType(repr.delim);
-    if (repr.type == repr_type::quoted)
+
+    static void widen(const void* block, void* out) noexcept
     {
-        if (repr.string == repr.delim || repr.string == repr.escape)
-            oss << StreamCharType(repr.escape);
-        oss << StreamCharType(repr.string);
+        const auto chars { _mm_loadu_si128(static_cast<const __m128i*>(block)) };
+        const auto zero { _mm_setzero_si128() };
+        auto* o { static_cast<__m128i*>(out) };
+        _mm_storeu_si128(o, _mm_unpacklo_epi8(chars, zero));
+        _mm_storeu_si128(o + 1, _mm_unpackhi_epi8(chars, zero));
     }
-    else
-        insert_escaped_char(oss, repr, repr.string);
-    oss << StreamCharType(repr.delim);
-    return ostream << oss.str();
-}
+};
 
-template <typename StreamCharType, typename CharType, typename StringCharType>
-auto operator<<(
-    std::basic_ostream<StreamCharType>& ostream,
-    const string_repr<CharType*, StringCharType>& repr
-    ) -> std::enable_if_t<
-    std::is_same<StringCharType, std::remove_const_t<CharType>>::value,
-    std::basic_ostream<StreamCharType>&>
+template <>
+struct ascii_block<4>
 {
-    if (repr.type == repr_type::quoted &&
-        sizeof(StreamCharType) < sizeof(StringCharType))
+    static constexpr std::ptrdiff_t width { 4 };
+
+    static bool plain(const void* block, const int delim, const int escape) noexcept
     {
-        ostream.setstate(std::ios_base::failbit);
-        return ostream;
+        const auto chars { _mm_loadu_si128(static_cast<const __m128i*>(block)) };
+        const auto special { _mm_or_si128(
+            _mm_cmpeq_epi32(chars, _mm_set1_epi32(delim)),
+            _mm_cmpeq_epi32(chars, _mm_set1_epi32(escape))) };
+        const auto printable { _mm_and_si128(
+            _mm_cmpgt_epi32(chars, _mm_set1_epi32(0x1f)),
+            _mm_cmplt_epi32(chars, _mm_set1_epi32(0x7f))) };
+        return _mm_movemask_epi8(_mm_andnot_si128(special, printable)) == 0xffff;
     }
-    std::basic_ostringstream<StreamCharType> oss;
-    insert_literal_prefix<StreamCharType, StringCharType>(oss);
-    oss << StreamCharType(repr.delim);
-    if (repr.type == repr_type::quoted)
+
+    // narrows chars known to be 7-bit ASCII
+    static void narrow(const void* block, void* out) noexcept
     {
-        for (auto p { repr.string }; *p; ++p)
+        const auto* in { static_cast<const __m128i*>(block) };
+        const auto low { _mm_packs_epi32(
+            _mm_loadu_si128(in), _mm_loadu_si128(in + 1)) };
+        const auto high { _mm_packs_epi32(
+            _mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3)) };
+        _mm_storeu_si128(static_cast<__m128i*>(out), _mm_packus_epi16(low, high));
+    }
+
+    static void widen(const void* block, void* out) noexcept
+    {
+        const auto chars { _mm_loadu_si128(static_cast<const __m128i*>(block)) };
+        const auto zero { _mm_setzero_si128() };
+        const auto low { _mm_unpacklo_epi8(chars, zero) };
+        const auto high { _mm_unpackhi_epi8(chars, zero) };
+        auto* o { static_cast<__m128i*>(out) };
+        _mm_storeu_si128(o, _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(o + 1, _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(o + 2, _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(o + 3, _mm_unpackhi_epi16(high, zero));
+    }
+};
+#endif  // SSE2
+
+#if (__cplusplus < 201703L)
+template <std::size_t CharSize>
+constexpr std::ptrdiff_t ascii_block<CharSize>::width;
+#endif
+
+/**
+ * @brief gets the length of the run of chars at first which are encoded as
+ *   themselves in literal representations: printable 7-bit ASCII other than
+ *   delim and escape
+ * @notes tested a block at a time (see ascii_block) up to the block where the
+ *   run ends, which is left to the scalar loop
+ */
+template <typename CharType>
+static std::size_t literal_run_length(const CharType* first, const CharType* last,
+                                      const CharType delim, const CharType escape)
+{
+    using block_type = ascii_block<sizeof(CharType)>;
+
+    const auto* p { first };
+    if (block_type::width != 0)
+    {
+        for (; last - p >= block_type::width; p += block_type::width)
         {
-            if (*p == repr.delim || *p == repr.escape)
-                oss << StreamCharType(repr.escape);
-            oss << StreamCharType(*p);
+            if (!block_type::plain(p, static_cast<int>(delim),
+                                   static_cast<int>(escape)))
+                break;
         }
     }
-    else
+    for (; p != last; ++p)
     {
-        for (auto p { repr.string }; *p; ++p)
-            insert_escaped_char(oss, repr, *p);
+        if (!(*p > 0x1f && *p < 0x7f) || *p == delim || *p == escape)
+            break;
     }
-    oss << StreamCharType(repr.delim);
-    return ostream << oss.str();
+    return static_cast<std::size_t>(p - first);
 }
 
 /**
- * @brief helper to extract_string_repr, decodes/validates a literal prefix
- *   matching the target char type
+ * @brief SSSE3 validation of blocks of 16 bytes as the chars of a utf8
+ *   literal representation which need no escaping: printable 7-bit ASCII
+ *   other than delim and escape, and well-formed UTF-8 multi-byte sequences
+ * @notes
+ *   - the default, and without SSSE3, validates no blocks, leaving all chars
+ *       to scalar loops
+ *   - multi-byte sequences are checked with nibble lookup tables, as in
+ *       Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per
+ *       Byte": each byte is classified by the high nibble of its predecessor,
+ *       the low nibble of its predecessor and its own high nibble, with the
+ *       bitwise and of the three lookups flagging errors, and with bytes 2
+ *       or 3 past 3 or 4 byte leads having to be continuations
  */
-template<typename StreamCharType, typename StringCharType>
-static void extract_literal_prefix(
-    std::basic_istream<StreamCharType>& istream)
+template <std::size_t CharSize>
+struct utf8_block
 {
-    if (std::is_same<StringCharType, wchar_t>::value &&
-        istream.get() != StreamCharType('L'))
+    static std::size_t run_length(const void* /*first*/, const std::size_t /*size*/,
+                                  const int /*delim*/, const int /*escape*/) noexcept
+    {
+        return 0;
+    }
+};
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+template <>
+struct utf8_block<1>
+{
+    /**
+     * @brief gets the length of the run of whole blocks at first which need
+     *   no escaping, less any multi-byte sequence left unfinished at its end
+     */
+    static std::size_t run_length(const void* first, const std::size_t size,
+                                  const int delim, const int escape) noexcept
+    {
+        // error flags, set by byte pairs as named, and by lookups of each
+        //   nibble for the pairs it could belong to
+        static constexpr char too_short { 1 << 0 };     // lead, then no continuation
+        static constexpr char too_long { 1 << 1 };      // ASCII, then continuation
+        static constexpr char overlong_3 { 1 << 2 };    // e0, then 80-9f
+        static constexpr char too_large { 1 << 3 };     // f4, then 90-bf, or f5-ff
+        static constexpr char surrogate { 1 << 4 };     // ed, then a0-bf
+        static constexpr char overlong_2 { 1 << 5 };    // c0-c1
+        static constexpr char too_large_1000 { 1 << 6 };// f5-ff, then 80-8f
+        static constexpr char overlong_4 { 1 << 6 };    // f0, then 80-8f
+        static constexpr char two_conts { char(1 << 7) };  // continuation, then continuation
+        static constexpr char carry { too_short | too_long | two_conts };
+
+        const auto byte_1_high_table { _mm_setr_epi8(
+            too_long, too_long, too_long, too_long,
+            too_long, too_long, too_long, too_long,
+            two_conts, two_conts, two_conts, two_conts,
+            too_short | overlong_2,
+            too_short,
+            too_short | overlong_3 | surrogate,
+            too_short | too_large | too_large_1000 | overlong_4) };
+        const auto byte_1_low_table { _mm_setr_epi8(
+            carry | overlong_3 | overlong_2 | overlong_4,
+            carry | overlong_2,
+            carry,
+            carry,
+            carry | too_large,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000) };
+        const auto byte_2_high_table { _mm_setr_epi8(
+            too_short, too_short, too_short, too_short,
+            too_short, too_short, too_short, too_short,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_short, too_short, too_short, too_short) };
+        const auto nibble { _mm_set1_epi8(0x0f) };
+        const auto high_nibbles = [&nibble](const __m128i bytes) {
+            return _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+        };
+
+        const auto* bytes { static_cast<const unsigned char*>(first) };
+        auto prev { _mm_setzero_si128() };
+        std::size_t i {};
+        for (; size - i >= 16; i += 16)
+        {
+            const auto chars { _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(bytes + i)) };
+            const auto special { _mm_or_si128(
+                _mm_cmpeq_epi8(chars, _mm_set1_epi8(static_cast<char>(delim))),
+                _mm_cmpeq_epi8(chars, _mm_set1_epi8(static_cast<char>(escape)))) };
+            const auto printable { _mm_and_si128(
+                _mm_cmpgt_epi8(chars, _mm_set1_epi8(0x1f)),
+                _mm_cmplt_epi8(chars, _mm_set1_epi8(0x7f))) };
+            const auto ascii { _mm_cmpgt_epi8(chars, _mm_set1_epi8(-1)) };
+            auto error { _mm_andnot_si128(
+                _mm_andnot_si128(special, printable), ascii) };
+
+            const auto prev1 { _mm_alignr_epi8(chars, prev, 15) };
+            const auto pairs { _mm_and_si128(_mm_and_si128(
+                _mm_shuffle_epi8(byte_1_high_table, high_nibbles(prev1)),
+                _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, nibble))),
+                _mm_shuffle_epi8(byte_2_high_table, high_nibbles(chars))) };
+            // bytes 2 past e0-ff or 3 past f0-ff become 80-ff, and must be
+            //   continuations, cancelling two_conts
+            const auto must_be_continuation { _mm_and_si128(_mm_or_si128(
+                _mm_subs_epu8(_mm_alignr_epi8(chars, prev, 14),
+                              _mm_set1_epi8(char(0xe0 - 0x80))),
+                _mm_subs_epu8(_mm_alignr_epi8(chars, prev, 13),
+                              _mm_set1_epi8(char(0xf0 - 0x80)))),
+                _mm_set1_epi8(two_conts)) };
+            error = _mm_or_si128(error, _mm_xor_si128(pairs, must_be_continuation));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xffff)
+                break;
+            prev = chars;
+        }
+        // leads of sequences past the run were only checked with the bytes in it
+        for (std::size_t k { 1 }; k <= 3 && k <= i; ++k)
+        {
+            const auto byte { bytes[i - k] };
+            if (byte < 0x80)
+                break;
+            if (byte >= 0xc0)
+            {
+                if (k < utf8_sequence_length(byte) || utf8_sequence_length(byte) == 0)
+                    i -= k;
+                break;
+            }
+        }
+        return i;
+    }
+};
+#endif  // SSSE3
+
+/**
+ * @brief gets the length of the run of chars at first which are encoded as
+ *   themselves in utf8 representations: as with literal_run_length, and
+ *   well-formed UTF-8 multi-byte sequences
+ * @notes tested a block at a time (see utf8_block), with the rest of the run
+ *   found alternating literal_run_length and utf8_sequence_at
+ */
+template <typename CharType>
+static std::size_t utf8_run_length(const CharType* first, const CharType* last,
+                                   const CharType delim, const CharType escape)
+{
+    const auto* p { first + utf8_block<sizeof(CharType)>::run_length(
+        first, static_cast<std::size_t>(last - first),
+        static_cast<int>(delim), static_cast<int>(escape)) };
+    while (p != last)
+    {
+        p += literal_run_length(p, last, delim, escape);
+        if (p == last)
+            break;
+        const auto length { utf8_sequence_at(p, last) };
+        if (length == 0)
+            break;
+        p += length;
+    }
+    return static_cast<std::size_t>(p - first);
+}
+
+/**
+ * @brief helper to insert_plain_chars, converts chars representable in both
+ *   char types (7-bit ASCII where sizes differ), 16 at a time with SSE2
+ *   between single byte and wider chars
+ * @notes overloads as follows:
+ *   - default: char types of the same size, neither single byte, or without
+ *       SSE2
+ *   - narrowing to single byte chars
+ *   - widening from single byte chars
+ */
+template <typename ToType, typename FromType>
+struct is_bulk_narrowing : public std::integral_constant<bool,
+    sizeof(ToType) == 1 && sizeof(FromType) != 1 &&
+    ascii_block<sizeof(FromType)>::width != 0>
+{};
+
+template <typename ToType, typename FromType>
+struct is_bulk_widening : public std::integral_constant<bool,
+    sizeof(FromType) == 1 && sizeof(ToType) != 1 &&
+    ascii_block<sizeof(ToType)>::width != 0>
+{};
+
+template <typename ToType, typename FromType>
+static auto convert_chars(const FromType* first, const std::size_t count, ToType* out
+    ) noexcept -> std::enable_if_t<
+        !is_bulk_narrowing<ToType, FromType>::value &&
+        !is_bulk_widening<ToType, FromType>::value,
+        void>
+{
+    for (std::size_t i {}; i < count; ++i)
+        out[i] = ToType(first[i]);
+}
+
+template <typename ToType, typename FromType>
+static auto convert_chars(const FromType* first, const std::size_t count, ToType* out
+    ) noexcept -> std::enable_if_t<
+        is_bulk_narrowing<ToType, FromType>::value,
+        void>
+{
+    std::size_t i {};
+    for (; count - i >= 16; i += 16)
+        ascii_block<sizeof(FromType)>::narrow(first + i, out + i);
+    for (; i < count; ++i)
+        out[i] = ToType(first[i]);
+}
+
+template <typename ToType, typename FromType>
+static auto convert_chars(const FromType* first, const std::size_t count, ToType* out
+    ) noexcept -> std::enable_if_t<
+        is_bulk_widening<ToType, FromType>::value,
+        void>
+{
+    std::size_t i {};
+    for (; count - i >= 16; i += 16)
+        ascii_block<sizeof(ToType)>::widen(first + i, out + i);
+    for (; i < count; ++i)
+        out[i] = ToType(first[i]);
+}
+
+/**
+ * @brief helper to insert_literal_chars, ostreams chars that need no escaping
+ * @notes overloads as follows:
+ *   - default: string and stream char types differ, chars converted in bulk
+ *       through a local buffer
+ *   - matching string and stream char types, written all at once
+ */
+template <typename StreamCharType, typename StringCharType>
+static void insert_plain_chars(std::basic_ostream<StreamCharType>& os,
+                               const StringCharType* first, std::size_t count)
+{
+    static constexpr std::size_t buffer_size { 256 };
+    StreamCharType buffer[buffer_size];
+    while (count != 0)
+    {
+        const auto n { count < buffer_size ? count : buffer_size };
+        convert_chars(first, n, buffer);
+        os.write(buffer, static_cast<std::streamsize>(n));
+        first += n;
+        count -= n;
+    }
+}
+
+template <typename StreamCharType>
+static void insert_plain_chars(std::basic_ostream<StreamCharType>& os,
+                               const StreamCharType* first, const std::size_t count)
+{
+    os.write(first, static_cast<std::streamsize>(count));
+}
+
+/**
+ * @brief helper to operator<<(string_repr), ostreams one character from a
+ *   string representation
+ */
+template <typename StreamCharType, typename StringType, typename StringCharType>
+static void insert_escaped_char(
+    std::basic_ostream<StreamCharType>& os,
+    const string_repr<StringType, StringCharType>& repr,
+    const StringCharType c)
+{
+    if (c < 0x7f && std::isprint(c))
+    {
+        // literal_repr ctor enforces ASCII-printable delim and escape
+        if (c == repr.delim || c == repr.escape)
+            os << StreamCharType(repr.escape);
+        os << StreamCharType(c);
+        return;
+    }
+    const auto& by_value { repr.escapes.by_value };
+    const auto symbol { by_value.find(c) };
+    if (symbol != by_value.end())
+        os << StreamCharType(repr.escape) << StreamCharType(symbol->second);
+    else
+        insert_hex_escape(os, StreamCharType(repr.escape), c);  // custom escape
+}
+
+/**
+ * @brief helper to operator<<(string_repr), ostreams the chars of a literal or
+ *   utf8 string representation
+ * @notes runs of chars needing no escapes are found and inserted in bulk,
+ *   including with utf8 well-formed UTF-8 multi-byte sequences, when both
+ *   string and stream char types are single byte
+ */
+template <typename StreamCharType, typename StringType, typename StringCharType>
+static void insert_literal_chars(
+    std::basic_ostream<StreamCharType>& os,
+    const string_repr<StringType, StringCharType>& repr,
+    const StringCharType* first, const StringCharType* last)
+{
+    const bool passthrough { repr.type == repr_type::utf8 &&
+                             sizeof(StringCharType) == 1 &&
+                             sizeof(StreamCharType) == 1 };
+    while (first != last)
+    {
+        const auto run { passthrough ?
+            utf8_run_length(first, last, repr.delim, repr.escape) :
+            literal_run_length(first, last, repr.delim, repr.escape) };
+        insert_plain_chars(os, first, run);
+        first += run;
+        if (first == last)
+            break;
+        insert_escaped_char(os, repr, *first);
+        ++first;
+    }
+}
+
+// TBD maybe throw exeception rather than set failbit on quoted char size failure?
+/**
+ * @brief ostream operator for string representations
+ * @notes overloads as follows:
+ *   - default: handles (const) basic_string& and (const) basic_string_view&
+ *      represenations (potentially also (const) (CharT&)[] if not decayed?)
+ *   - single-char: handles (const) CharT& representations
+ *   - C string: handles (const) CharT* representations
+ */
+template<typename StreamCharType, typename StringType, typename StringCharType>
+auto operator<<(
+    std::basic_ostream<StreamCharType>& ostream,
+    const string_repr<StringType&, StringCharType>& repr
+    ) -> std::enable_if_t<
+    traits::is_stl_string_type<std::remove_const_t<StringType>>::value,
+    std::basic_ostream<StreamCharType>&>
+{
+    if (repr.type == repr_type::quoted &&
+        sizeof(StreamCharType) < sizeof(StringCharType))
+    {
+        ostream.setstate(std::ios_base::failbit);
+        return ostream;
+    }
+    std::basic_ostringstream<StreamCharType> oss;
+    insert_literal_prefix<StreamCharType, StringCharType>(oss);
+    oss << StreamCharType(repr.delim);
+    if (repr.type == repr_type::quoted)
+    {
+        for (const auto c : repr.string)
+        {
+            if (c == repr.delim || c == repr.escape)
+                oss << StreamCharType(repr.escape);
+            oss << StreamCharType(c);
+        }
+    }
+    else
+    {
+        insert_literal_chars(oss, repr, repr.string.data(),
+                             repr.string.data() + repr.string.size());
+    }
+    oss << StreamCharType(repr.delim);
+    return ostream << oss.str();
+}
+
+template <typename StreamCharType, typename CharType, typename StringCharType>
+auto operator<<(
+    std::basic_ostream<StreamCharType>& ostream,
+    const string_repr<CharType&, StringCharType>& repr
+    ) -> std::enable_if_t<
+    std::is_same<StringCharType, std::remove_const_t<CharType>>::value,
+    std::basic_ostream<StreamCharType>&>
+{
+    if (repr.type == repr_type::quoted &&
+        sizeof(StreamCharType) < sizeof(StringCharType))
+    {
+        ostream.setstate(std::ios_base::failbit);
+        return ostream;
+    }
+    std::basic_ostringstream<StreamCharType> oss;
+    insert_literal_prefix<StreamCharType, StringCharType>(oss);
+    oss << StreamCharType(repr.delim);
+    if (repr.type == repr_type::quoted)
+    {
+        if (repr.string == repr.delim || repr.string == repr.escape)
+            oss << StreamCharType(repr.escape);
+        oss << StreamCharType(repr.string);
+    }
+    else
+        insert_escaped_char(oss, repr, repr.string);
+    oss << StreamCharType(repr.delim);
+    return ostream << oss.str();
+}
+
+template <typename StreamCharType, typename CharType, typename StringCharType>
+auto operator<<(
+    std::basic_ostream<StreamCharType>& ostream,
+    const string_repr<CharType*, StringCharType>& repr
+    ) -> std::enable_if_t<
+    std::is_same<StringCharType, std::remove_const_t<CharType>>::value,
+    std::basic_ostream<StreamCharType>&>
+{
+    if (repr.type == repr_type::quoted &&
+        sizeof(StreamCharType) < sizeof(StringCharType))
+    {
+        ostream.setstate(std::ios_base::failbit);
+        return ostream;
+    }
+    std::basic_ostringstream<StreamCharType> oss;
+    insert_literal_prefix<StreamCharType, StringCharType>(oss);
+    oss << StreamCharType(repr.delim);
+    if (repr.type == repr_type::quoted)
+    {
+        for (auto p { repr.string }; *p; ++p)
+        {
+            if (*p == repr.delim || *p == repr.escape)
+                oss << StreamCharType(repr.escape);
+            oss << StreamCharType(*p);
+        }
+    }
+    else
+    {
+        insert_literal_chars(
+            oss, repr, repr.string,
+            repr.string + std::char_traits<StringCharType>::length(repr.string));
+    }
+    oss << StreamCharType(repr.delim);
+    return ostream << oss.str();
+}
+
+/**
+ * @brief helper to extract_string_repr, decodes/validates a literal prefix
+ *   matching the target char type
+ */
+template<typename StreamCharType, typename StringCharType>
+static void extract_literal_prefix(
+    std::basic_istream<StreamCharType>& istream)
+{
+    if (std::is_same<StringCharType, wchar_t>::value &&
+        istream.get() != StreamCharType('L'))
         istream.setstate(std::ios_base::failbit);
 
 #if (__cplusplus > 201703L)
@@ -863,44 +1562,116 @@ static void extract_literal_prefix(
         istream.setstate(std::ios_base::failbit);
 }
 
+/**
+ * @brief nibble values of 7-bit ASCII chars, or -1 for non hex digits
+ */
+static constexpr signed char hex_values[128] {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
 /**
  * @brief helper to extract_string_repr, decodes a hex escaped value and
  *   validates that it matches the width of the target char type
+ * @notes reads exactly 2*sizeof(StringCharType) digits from the stream
+ *   buffer, accumulating nibbles from hex_values as each digit is validated;
+ *   failbit is set on the first non hex digit, which is left in the stream,
+ *   and eofbit with it if the stream ends first
  */
 template<typename StreamCharType, typename StringCharType>
-static int64_t extract_fixed_width_hex_value(
+static StringCharType extract_fixed_width_hex_value(
     std::basic_istream<StreamCharType>& istream)
 {
-    static constexpr uint32_t hex_length { sizeof(StringCharType) * 2 };
-    // strtol expects char* (not using wcstol due to variable size of wchar_t)
-    char buff[hex_length + 1] {};
-    char *p { buff };
-    // malformed hex strings could have values larger than StreamCharType max,
-    //   with unpredictable overflows, so we need to pre-screen one by one
-    //   rather than just call `get(buff, hex_length + 1)`
-    StreamCharType c;
-    for (uint32_t i {}; istream.good() && i < hex_length; ++i, ++p)
+    using traits_type = typename std::basic_istream<StreamCharType>::traits_type;
+    static constexpr std::size_t hex_length { sizeof(StringCharType) * 2 };
+
+    auto* buf { istream.rdbuf() };
+    std::uint_least32_t value {};
+    for (std::size_t i {}; i < hex_length; ++i)
     {
-        istream >> c;
-        if (c > 0x7f || !isxdigit(c))
+        const auto ic { buf->sgetc() };
+        if (traits_type::eq_int_type(ic, traits_type::eof()))
+        {
+            istream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+            break;
+        }
+        // compared as unsigned, as StreamCharType may be signed
+        const auto c { static_cast<typename std::make_unsigned<StreamCharType>::type>(
+            traits_type::to_char_type(ic)) };
+        const int nibble { c < 128 ? hex_values[c] : -1 };
+        if (nibble < 0)
+        {
+            istream.setstate(std::ios_base::failbit);
             break;
-        *p = c;
+        }
+        value = (value << 4) | static_cast<std::uint_least32_t>(nibble);
+        buf->sbumpc();
     }
-    if (p != &buff[hex_length])
-        istream.setstate(std::ios_base::failbit);
-    // strtol returns signed values, but interprets hex as unsigned
-    return std::strtol(buff, nullptr, 16);
+    return StringCharType(value);
+}
+
+/**
+ * @brief helper to extract_plain_run, appends chars decoded as themselves
+ * @notes overloads as follows:
+ *   - default: any buffer supporting `buffer += StringCharType`, one at a time
+ *   - basic_string: converted in bulk (see convert_chars) into its storage
+ */
+template <typename StringCharType, typename BufferType, typename StreamCharType>
+static void append_plain_chars(BufferType& buffer, const StreamCharType* first,
+                               const std::size_t count)
+{
+    for (std::size_t i {}; i < count; ++i)
+        buffer += StringCharType(first[i]);
+}
+
+template <typename StringCharType, typename StreamCharType>
+static void append_plain_chars(std::basic_string<StringCharType>& buffer,
+                               const StreamCharType* first, const std::size_t count)
+{
+    const auto size { buffer.size() };
+    buffer.resize(size + count);
+    convert_chars(first, count, &buffer[size]);
+}
+
+/**
+ * @brief helper to extract_literal_repr, when reading directly from the region
+ *   of a memory::basic_input_buffer, decodes the run of chars at its next
+ *   position which are encoded as themselves (see literal_run_length and
+ *   utf8_run_length) in bulk, rather than a char at a time through the stream
+ */
+template<typename StreamCharType, typename StringType, typename StringCharType,
+         typename BufferType>
+static void extract_plain_run(
+    memory::basic_input_buffer<StreamCharType>& region,
+    const string_repr<StringType, StringCharType>& repr, const bool passthrough,
+    BufferType& buffer)
+{
+    const auto* first { region.next() };
+    const auto* last { region.end() };
+    const auto delim { StreamCharType(repr.delim) };
+    const auto escape { StreamCharType(repr.escape) };
+    const auto run { passthrough ? utf8_run_length(first, last, delim, escape) :
+                                   literal_run_length(first, last, delim, escape) };
+    append_plain_chars<StringCharType>(buffer, first, run);
+    region.set_next(first + run);
 }
 
 /**
  * @brief helper to extract_string_repr, encapsulates main quoted representation
  *   decoding loop
  */
-template<typename StreamCharType, typename StringCharType>
+template<typename StreamCharType, typename StringType, typename StringCharType,
+         typename BufferType>
 static void extract_quoted_repr(
     std::basic_istream<StreamCharType>& istream,
-    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr,
-    std::basic_string<StringCharType>& buffer)
+    const string_repr<StringType, StringCharType>& repr,
+    BufferType& buffer)
 {
     StreamCharType c;
     std::ios_base::fmtflags orig_flags {
@@ -929,20 +1700,60 @@ static void extract_quoted_repr(
 }
 
 /**
- * @brief helper to extract_string_repr, encapsulates main literal
+ * @brief helper to extract_literal_repr, decodes the rest of a UTF-8 multi-byte
+ *   sequence from its lead byte, appending it to buffer only if well-formed
+ * @notes expects skipws to be unset, as in extract_literal_repr
+ */
+template<typename StringCharType, typename StreamCharType, typename BufferType>
+static bool extract_utf8_sequence(
+    std::basic_istream<StreamCharType>& istream, StreamCharType c,
+    BufferType& buffer)
+{
+    const auto lead { static_cast<unsigned char>(c) };
+    const auto length { utf8_sequence_length(lead) };
+    if (length == 0)
+        return false;
+    StringCharType sequence[4] { StringCharType(c) };
+    for (std::size_t i { 1 }; i < length; ++i)
+    {
+        istream >> c;
+        const auto byte { static_cast<unsigned char>(c) };
+        if (!istream.good() ||
+            (i == 1 ? !is_utf8_second_byte(lead, byte) : (byte < 0x80 || byte > 0xbf)))
+            return false;
+        sequence[i] = StringCharType(c);
+    }
+    for (std::size_t i {}; i < length; ++i)
+        buffer += sequence[i];
+    return true;
+}
+
+/**
+ * @brief helper to extract_string_repr, encapsulates main literal (and utf8)
  *   representation decoding loop
  */
-template<typename StreamCharType, typename StringCharType>
+template<typename StreamCharType, typename StringType, typename StringCharType,
+         typename BufferType>
 static void extract_literal_repr(
     std::basic_istream<StreamCharType>& istream,
-    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr,
-    std::basic_string<StringCharType>& buffer)
+    const string_repr<StringType, StringCharType>& repr,
+    BufferType& buffer)
 {
+    const bool passthrough { repr.type == repr_type::utf8 &&
+                             sizeof(StringCharType) == 1 &&
+                             sizeof(StreamCharType) == 1 };
+    auto* const region {
+        dynamic_cast<memory::basic_input_buffer<StreamCharType>*>(istream.rdbuf()) };
     StreamCharType c;
+    // extracts next char, after any plain run when reading from memory
+    const auto next = [&istream, &repr, &buffer, &c, region, passthrough]() {
+        if (region != nullptr && istream.good())
+            extract_plain_run(*region, repr, passthrough, buffer);
+        istream >> c;
+    };
     std::ios_base::fmtflags orig_flags {
         istream.flags(istream.flags() & ~std::ios_base::skipws) };
-    for (istream >> c;
-         istream.good() && c != StreamCharType(repr.delim); istream >> c)
+    for (next(); istream.good() && c != StreamCharType(repr.delim); next())
     {
         if (c < 0x7f && std::isprint(c))
         {
@@ -962,23 +1773,25 @@ static void extract_literal_repr(
                 buffer += StringCharType(c);
                 continue;
             }
-            try
+            const auto& by_symbol { repr.escapes.by_symbol };
+            const auto symbol { by_symbol.find(StringCharType(c)) };
+            if (symbol != by_symbol.end())
             {
-                buffer += repr.escapes.by_symbol.at(c);
+                buffer += symbol->second;
                 continue;
             }
-            catch (const std::out_of_range& /*oor_ex*/)
+            if (c == StreamCharType('x'))
             {
-                if (c == StreamCharType('x'))
-                {
-                    // !!? can we pass only StringCharType to template?
-                    buffer += StringCharType(
-                        extract_fixed_width_hex_value<
-                        StreamCharType, StringCharType>(istream));
-                    continue;
-                }
+                buffer += extract_fixed_width_hex_value<
+                    StreamCharType, StringCharType>(istream);
+                continue;
             }
         }
+        else if (passthrough &&
+                 extract_utf8_sequence<StringCharType>(istream, c, buffer))
+        {
+            continue;
+        }
         istream.setstate(std::ios_base::failbit);  // invalid literal encoding
     };
     if (c != StreamCharType(repr.delim))
@@ -987,13 +1800,73 @@ static void extract_literal_repr(
 }
 
 /**
- * @brief helper to operator>>(string_repr), differentiates between quoted and
- *   literal decoding
+ * @brief helper to extract_string_repr, decodes the delimited portion of a
+ *   string representation (everything after the literal prefix) into buffer,
+ *   differentiating between quoted and literal decoding
  */
-template<typename StreamCharType, typename StringCharType>
+template<typename StreamCharType, typename StringType, typename StringCharType,
+         typename BufferType>
+static void extract_delimited_repr(
+    std::basic_istream<StreamCharType>& istream,
+    const string_repr<StringType, StringCharType>& repr,
+    BufferType& buffer)
+{
+    // get() returns std::basic_istream<StreamCharType>::int_type
+    if (StreamCharType(istream.get()) != StreamCharType(repr.delim))
+        istream.setstate(std::ios_base::failbit);
+    if (!istream.good())
+        return;
+    if (repr.type == repr_type::quoted)
+        extract_quoted_repr(istream, repr, buffer);
+    else
+        extract_literal_repr(istream, repr, buffer);
+}
+
+/**
+ * @brief sink for decoded string chars that only counts them, allowing string
+ *   representations to be validated without storing the decoded string
+ */
+template <typename CharType>
+struct counting_sink
+{
+    std::size_t size;
+
+    counting_sink& operator+=(const CharType /*c*/) noexcept
+    {
+        ++size;
+        return *this;
+    }
+};
+
+/**
+ * @brief per-thread buffer for decoding strings before they are assigned to
+ *   their target, reused across strings so that its capacity is only
+ *   allocated once per thread
+ * @notes cleared by each use; decoding does not nest, so one buffer per char
+ *   type suffices
+ */
+template <typename CharType>
+static std::basic_string<CharType>& scratch_string()
+{
+    static thread_local std::basic_string<CharType> scratch;
+    scratch.clear();
+    return scratch;
+}
+
+/**
+ * @brief helper to operator>>(string_repr), validates char type constraints
+ *   and literal prefix before decoding into buffer
+ * @notes overloads as follows:
+ *   - default: decodes into buffer, which can be a basic_string or any type
+ *       supporting `buffer += StringCharType`, eg counting_sink or char_sink
+ *   - basic_string&: decodes into repr.string, leaving it unmodified on failure
+ */
+template<typename StreamCharType, typename StringType, typename StringCharType,
+         typename BufferType>
 static void extract_string_repr(
     std::basic_istream<StreamCharType>& istream,
-    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr)
+    const string_repr<StringType, StringCharType>& repr,
+    BufferType& buffer)
 {
     // quoted encoding expects full potential range of StreamCharType values,
     //   and so could create overflow if casting to a smaller StringCharType,
@@ -1008,18 +1881,59 @@ static void extract_string_repr(
     extract_literal_prefix<StreamCharType, StringCharType>(istream);
     if (!istream.good())
         return;
-    // get() returns std::basic_istream<StreamCharType>::int_type
-    if (StreamCharType(istream.get()) != StreamCharType(repr.delim))
-        istream.setstate(std::ios_base::failbit);
-    if (!istream.good())
-        return;
-    std::basic_string<StringCharType> temp;
-    if (repr.type == repr_type::quoted)
-        extract_quoted_repr(istream, repr, temp);
-    else
-        extract_literal_repr(istream, repr, temp);
+    extract_delimited_repr(istream, repr, buffer);
+}
+
+template<typename StreamCharType, typename StringCharType>
+static void extract_string_repr(
+    std::basic_istream<StreamCharType>& istream,
+    const string_repr<std::basic_string<StringCharType>&, StringCharType>& repr)
+{
+    // assigned rather than moved from scratch, reusing the capacity of both
+    auto& scratch { scratch_string<StringCharType>() };
+    extract_string_repr(istream, repr, scratch);
+    if (istream.good())
+        repr.string.assign(scratch);
+}
+
+/**
+ * @brief sink for decoding a char representation, holding the first decoded
+ *   char and failing the stream on any further one, so that decoding stops
+ *   there rather than at the closing delimiter
+ */
+template <typename StreamCharType, typename CharType>
+struct char_sink
+{
+    std::basic_istream<StreamCharType>& istream;
+    CharType value;
+    std::size_t size;
+
+    char_sink& operator+=(const CharType c)
+    {
+        if (size++ == 0)
+            value = c;
+        else
+            istream.setstate(std::ios_base::failbit);
+        return *this;
+    }
+};
+
+/**
+ * @brief helper to operator>>(string_repr), decodes a char representation as
+ *   extract_string_repr would a string of size 1
+ * @notes repr.string is only modified on success
+ */
+template<typename StreamCharType, typename StringCharType>
+static void extract_char_repr(
+    std::basic_istream<StreamCharType>& istream,
+    const string_repr<StringCharType&, StringCharType>& repr)
+{
+    char_sink<StreamCharType, StringCharType> sink { istream, StringCharType(), 0 };
+    extract_string_repr(istream, repr, sink);
+    if (sink.size == 0)
+        istream.setstate(std::ios_base::failbit);  // empty representation
     if (istream.good())
-        repr.string = std::move(temp);
+        repr.string = sink.value;
 }
 
 /**
@@ -1034,14 +1948,7 @@ auto operator>>(
     const string_repr<StringCharType&, StringCharType>& repr
     ) -> std::basic_istream<StreamCharType>&
 {
-    std::basic_string<StringCharType> temp;
-    string_repr<std::basic_string<StringCharType>&, StringCharType> temp_repr {
-        temp, repr.delim, repr.escape, repr.type };
-    extract_string_repr(istream, temp_repr);
-    if (!istream.fail() && temp_repr.string.size() == 1)
-        repr.string = temp_repr.string[0];
-    else
-        istream.setstate(std::ios_base::failbit);
+    extract_char_repr(istream, repr);
     return istream;
 }
 
@@ -1083,6 +1990,20 @@ std::basic_ios<CharType, TraitsType>& quotedrepr(
     return stream;
 }
 
+/**
+ * @brief iomanip to set encoding/decoding of strings/chars in containers to
+ *   utf8, a variant of literal which leaves well-formed UTF-8 multi-byte
+ *   sequences unescaped
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& utf8repr(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_manip_i()) =
+        static_cast<int>(detail::repr_type::utf8);
+    return stream;
+}
+
 /**
  * @brief generates quoted string represenation intended for use with stream
  *   operators
@@ -1301,19 +2222,79 @@ inline auto literal(
  */
 namespace decorator {
 
+/**
+ * @brief gets length of a token at compile time, with null tokens being empty
+ */
+template <typename CharType>
+constexpr std::size_t token_length(const CharType* token)
+{
+    return token == nullptr || *token == CharType('\0') ?
+        0 : 1 + token_length(token + 1);
+}
+
 /**
  * @brief wraps tokens used around and between elements in serialization of a
- *   given set of container types
+ *   given set of container types, along with their lengths
  */
 template <typename CharType>
 struct delim_wrapper
 {
+    constexpr delim_wrapper(const CharType* prefix_, const CharType* separator_,
+                            const CharType* whitespace_, const CharType* suffix_) :
+        prefix(prefix_), separator(separator_), whitespace(whitespace_),
+        suffix(suffix_), prefix_length(token_length(prefix_)),
+        separator_length(token_length(separator_)),
+        whitespace_length(token_length(whitespace_)),
+        suffix_length(token_length(suffix_))
+    {}
+
     const CharType* prefix;
     const CharType* separator;
     const CharType* whitespace;
     const CharType* suffix;
+    std::size_t prefix_length;
+    std::size_t separator_length;
+    std::size_t whitespace_length;
+    std::size_t suffix_length;
+};
+
+/**
+ * @brief null-terminated token of fixed length, built at compile time
+ */
+template <typename CharType, std::size_t Length>
+struct fixed_token
+{
+    CharType chars[Length + 1];
+};
+
+namespace detail {
+
+template <std::size_t... Indices>
+struct index_list
+{};
+
+template <std::size_t Count, std::size_t... Indices>
+struct make_index_list : make_index_list<Count - 1, Count - 1, Indices...>
+{};
+
+template <std::size_t... Indices>
+struct make_index_list<0, Indices...>
+{
+    using type = index_list<Indices...>;
 };
 
+template <typename CharType, std::size_t... Indices>
+constexpr fixed_token<CharType, sizeof...(Indices)> concatenate(
+    const CharType* first, const std::size_t first_length,
+    const CharType* second, index_list<Indices...>)
+{
+    return { { (Indices < first_length ?
+                first[Indices] : second[Indices - first_length])...,
+               CharType('\0') } };
+}
+
+}  // namespace detail
+
 using namespace strings::compile_time;  // char_literal, string_literal
 
 // TBD consider making map/multimap curly braced, as they are essentially sets of pairs
@@ -1382,6 +2363,39 @@ struct delimiters<std::tuple<DataType...>, CharType>
         STRING_LITERAL(CharType, ">") };
 };
 
+/**
+ * @brief separator token fused with the whitespace following it, so that
+ *   both can be inserted with one write
+ * @notes derived from delimiters, so also covers its specializations
+ */
+template <typename ContainerType, typename CharType>
+struct fused_separator
+{
+    static constexpr delim_wrapper<CharType> decorators {
+        delimiters<ContainerType, CharType>::values };
+
+    static constexpr std::size_t length {
+        decorators.separator_length + decorators.whitespace_length };
+
+    static constexpr fixed_token<CharType, length> value {
+        detail::concatenate(decorators.separator, decorators.separator_length,
+                            decorators.whitespace,
+                            typename detail::make_index_list<length>::type {}) };
+};
+
+#if (__cplusplus < 201703L)
+// out-of-class definitions required when odr-used before C++17 inline variables
+template <typename ContainerType, typename CharType>
+constexpr delim_wrapper<CharType> fused_separator<ContainerType, CharType>::decorators;
+
+template <typename ContainerType, typename CharType>
+constexpr std::size_t fused_separator<ContainerType, CharType>::length;
+
+template <typename ContainerType, typename CharType>
+constexpr fixed_token<CharType, fused_separator<ContainerType, CharType>::length>
+    fused_separator<ContainerType, CharType>::value;
+#endif  // pre-C++17
+
 }  // namespace decorator
 
 /**
@@ -1390,6 +2404,22 @@ struct delimiters<std::tuple<DataType...>, CharType>
  */
 namespace input {
 
+/**
+ * @brief state of one top-level from_stream call, shared by all of its
+ *   nesting levels, and passed to formatter hooks which take it as a last
+ *   parameter
+ */
+template <typename StreamType>
+struct context
+{
+    explicit context(StreamType& istream) :
+        repr { strings::detail::get_repr(istream) }
+    {}
+
+    strings::detail::repr_type repr;  // of string and char elements
+    std::size_t depth {};             // of container being parsed, 0 at top
+};
+
 /**
  * @brief default formatter for the parsing of decorators and elements in a
  *   container serialization
@@ -1405,31 +2435,61 @@ struct default_formatter
 
     /**
      * @brief attempts stream extraction of an exact token
+     * @notes compares chars directly in the stream buffer, with the length of
+     *   the token known (eg decorators.separator_length, a constant expression
+     *   so that the single char path folds away at compile time)
      */
-    static void extract_token(StreamType& istream, const stream_char_type* token)
+    static void extract_token(StreamType& istream, const stream_char_type* token,
+                              const std::size_t length)
     {
+        using traits_type = typename StreamType::traits_type;
+
         if (token == nullptr)
         {
             istream.setstate(std::ios_base::failbit);
             return;
         }
-        auto token_s {
-#if (__cplusplus >= 201703L)
-            std::basic_string_view<stream_char_type> { token }
-#else
-            std::basic_string<stream_char_type> { token }
-#endif
-        };
+        // single char tokens (all defaults) are usually not preceded by
+        //   whitespace, so are matched before skipping any
+        if (length == 1 && istream.good())
+        {
+            auto* buf { istream.rdbuf() };
+            const auto ic { buf->sgetc() };
+            if (!traits_type::eq_int_type(ic, traits_type::eof()) &&
+                traits_type::eq(traits_type::to_char_type(ic), *token))
+            {
+                buf->sbumpc();
+                return;
+            }
+        }
         istream >> std::ws;
-        auto it_1 { token_s.begin() };
-        while (istream.good() && it_1 != token_s.end() &&
-               stream_char_type(istream.peek()) == *it_1)
+        if (!istream.good())
         {
-            istream.get();
-            ++it_1;
+            if (length != 0)
+                istream.setstate(std::ios_base::failbit);
+            return;
         }
-        if (it_1 != token_s.end())
-            istream.setstate(std::ios_base::failbit);
+        auto* buf { istream.rdbuf() };
+        for (std::size_t i {}; i < length; ++i)
+        {
+            const auto ic { buf->sgetc() };
+            if (traits_type::eq_int_type(ic, traits_type::eof()))
+            {
+                istream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+                return;
+            }
+            if (!traits_type::eq(traits_type::to_char_type(ic), token[i]))
+            {
+                istream.setstate(std::ios_base::failbit);
+                return;
+            }
+            buf->sbumpc();
+        }
+    }
+
+    static void extract_token(StreamType& istream, const stream_char_type* token)
+    {
+        extract_token(istream, token, decorator::token_length(token));
     }
 
     /**
@@ -1437,7 +2497,7 @@ struct default_formatter
      */
     static void parse_prefix(StreamType& istream) noexcept
     {
-        extract_token(istream, decorators.prefix);
+        extract_token(istream, decorators.prefix, decorators.prefix_length);
     }
 
     /**
@@ -1447,6 +2507,9 @@ struct default_formatter
      *   - CharT&
      *   - (CharT&)[] (invoked in case of nested C arrays, eg CharT[][])
      *   - basic_string&
+     *   - with call context: as above for char and string types, using repr
+     *       of context
+     *   - with call context: nested containers, parsed with the same context
      */
     template<typename ElementType>
     static auto parse_element(StreamType& istream, ElementType& element
@@ -1463,11 +2526,7 @@ struct default_formatter
             traits::is_char_type<ElementType>::value,
             void>
     {
-        if (static_cast<repr_type>(
-                istream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            istream >> std::ws >> strings::quoted(element);
-        else
-            istream >> std::ws >> strings::literal(element);
+        parse_string(istream, element, strings::detail::get_repr(istream));
     }
 
     template <typename CharType, std::size_t ArraySize>
@@ -1477,32 +2536,59 @@ struct default_formatter
             traits::is_char_type<CharType>::value,
             void>
     {
-        std::basic_string<CharType> s;
-        if (static_cast<repr_type>(
-                istream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            istream >> std::ws >> strings::quoted(s);
-        else
-            istream >> std::ws >> strings::literal(s);
-        if (s.size() < ArraySize)
-        {
-            auto it {std::copy(s.begin(), s.end(), std::begin(element))};
-            std::fill(it, std::end(element), CharType('\0'));
-        }
-        else
-        {
-            istream.setstate(std::ios_base::failbit);
-        }
+        parse_string(istream, element, strings::detail::get_repr(istream));
     }
 
     template<typename CharType>
     static void parse_element(StreamType& istream,
                               std::basic_string<CharType>& element)
     {
-        if (static_cast<repr_type>(
-                istream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            istream >> std::ws >> strings::quoted(element);
-        else
-            istream >> std::ws >> strings::literal(element);
+        parse_string(istream, element, strings::detail::get_repr(istream));
+    }
+
+    template<typename ElementType>
+    static auto parse_element(StreamType& istream, ElementType& element,
+                              context<StreamType>& call_context
+        ) noexcept -> std::enable_if_t<
+            traits::is_char_type<ElementType>::value,
+            void>
+    {
+        parse_string(istream, element, call_context.repr);
+    }
+
+    template <typename CharType, std::size_t ArraySize>
+    static auto parse_element(
+        StreamType& istream, CharType (&element)[ArraySize],
+        context<StreamType>& call_context
+        ) noexcept -> std::enable_if_t<
+            traits::is_char_type<CharType>::value,
+            void>
+    {
+        parse_string(istream, element, call_context.repr);
+    }
+
+    template<typename CharType>
+    static void parse_element(StreamType& istream,
+                              std::basic_string<CharType>& element,
+                              context<StreamType>& call_context)
+    {
+        parse_string(istream, element, call_context.repr);
+    }
+
+    template<typename ElementType>
+    static auto parse_element(StreamType& istream, ElementType& element,
+                              context<StreamType>& call_context
+        ) -> std::enable_if_t<
+            traits::is_parseable_as_container<ElementType>::value,
+            void>
+    {
+        // unqualified, as from_stream overloads are declared later and found
+        //   by ADL on context
+        istream >> std::ws;
+        ++call_context.depth;
+        from_stream(istream, element, default_formatter<ElementType, StreamType>{},
+                    call_context);
+        --call_context.depth;
     }
 
     /**
@@ -1510,7 +2596,7 @@ struct default_formatter
      */
     static void parse_separator(StreamType& istream) noexcept
     {
-        extract_token(istream, decorators.separator);
+        extract_token(istream, decorators.separator, decorators.separator_length);
     }
 
     /**
@@ -1518,10 +2604,115 @@ struct default_formatter
      */
     static void parse_suffix(StreamType& istream) noexcept
     {
-        extract_token(istream, decorators.suffix);
+        extract_token(istream, decorators.suffix, decorators.suffix_length);
+    }
+
+private:
+    template<typename ElementType>
+    static void parse_string(StreamType& istream, ElementType& element,
+                             const repr_type repr)
+    {
+        if (repr == repr_type::quoted)
+            istream >> std::ws >> strings::quoted(element);
+        else
+            istream >> std::ws >> strings::detail::with_type(
+                strings::literal(element), repr);
+    }
+
+    template <typename CharType, std::size_t ArraySize>
+    static void parse_string(StreamType& istream, CharType (&element)[ArraySize],
+                             const repr_type repr)
+    {
+        // decoded into the per-thread scratch buffer, rather than a string
+        //   allocated per element, and left empty on failure
+        auto& s { strings::detail::scratch_string<CharType>() };
+        istream >> std::ws;
+        if (repr == repr_type::quoted)
+            strings::detail::extract_string_repr(istream, strings::quoted(s), s);
+        else
+            strings::detail::extract_string_repr(
+                istream, strings::detail::with_type(strings::literal(s), repr), s);
+        if (!istream.good())
+            s.clear();
+        if (s.size() < ArraySize)
+        {
+            auto it {std::copy(s.begin(), s.end(), std::begin(element))};
+            std::fill(it, std::end(element), CharType('\0'));
+        }
+        else
+        {
+            istream.setstate(std::ios_base::failbit);
+        }
     }
 };
 
+/**
+ * @brief helpers to from_stream, invoke formatter hooks with the call context
+ *   if they take it as a last parameter, or without it otherwise
+ */
+template <typename FormatterType, typename StreamType, typename ContextType>
+static auto invoke_parse_prefix(const FormatterType& formatter, StreamType& istream,
+                                ContextType& context, int
+    ) -> decltype(formatter.parse_prefix(istream, context), void())
+{
+    formatter.parse_prefix(istream, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static void invoke_parse_prefix(const FormatterType& formatter, StreamType& istream,
+                                ContextType& /*context*/, long)
+{
+    formatter.parse_prefix(istream);
+}
+
+template <typename FormatterType, typename StreamType, typename ElementType,
+          typename ContextType>
+static auto invoke_parse_element(const FormatterType& formatter, StreamType& istream,
+                                 ElementType& element, ContextType& context, int
+    ) -> decltype(formatter.parse_element(istream, element, context), void())
+{
+    formatter.parse_element(istream, element, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ElementType,
+          typename ContextType>
+static void invoke_parse_element(const FormatterType& formatter, StreamType& istream,
+                                 ElementType& element, ContextType& /*context*/,
+                                 long)
+{
+    formatter.parse_element(istream, element);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static auto invoke_parse_separator(const FormatterType& formatter, StreamType& istream,
+                                   ContextType& context, int
+    ) -> decltype(formatter.parse_separator(istream, context), void())
+{
+    formatter.parse_separator(istream, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static void invoke_parse_separator(const FormatterType& formatter, StreamType& istream,
+                                   ContextType& /*context*/, long)
+{
+    formatter.parse_separator(istream);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static auto invoke_parse_suffix(const FormatterType& formatter, StreamType& istream,
+                                ContextType& context, int
+    ) -> decltype(formatter.parse_suffix(istream, context), void())
+{
+    formatter.parse_suffix(istream, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static void invoke_parse_suffix(const FormatterType& formatter, StreamType& istream,
+                                ContextType& /*context*/, long)
+{
+    formatter.parse_suffix(istream);
+}
+
 /**
  * @brief helper to array_from_stream and from_stream overloads, used to move
  *   elements which themselves may be nested containers with C arrays at some
@@ -1555,17 +2746,18 @@ static void c_array_compatible_move_assignment(ElementType (&source)[ArraySize],
 /**
  * @brief wraps logic for C array and std::array overloads of from_stream
  */
-template <typename ContainerType, typename StreamType, typename FormatterType>
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename ContextType>
 static StreamType& array_from_stream(
     StreamType& istream, ContainerType& container,
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
-    formatter.parse_prefix(istream);
+    invoke_parse_prefix(formatter, istream, context, 0);
     if (!istream.good())
         return istream;
 
     if (container_stream_io::traits::is_empty(container)) {
-        formatter.parse_suffix(istream);
+        invoke_parse_suffix(formatter, istream, context, 0);
         return istream;
     }
 
@@ -1573,17 +2765,17 @@ static StreamType& array_from_stream(
     auto tc_it {std::begin(temp_container)};
     auto tc_end {std::end(temp_container)};
 
-    formatter.parse_element(istream, *tc_it);
+    invoke_parse_element(formatter, istream, *tc_it, context, 0);
     if (!istream.good())
         return istream;
     ++tc_it;
 
     for (; !istream.eof() && tc_it != tc_end; ++tc_it) {
-        formatter.parse_separator(istream);
+        invoke_parse_separator(formatter, istream, context, 0);
         if (!istream.good())
             return istream;
 
-        formatter.parse_element(istream, *tc_it);
+        invoke_parse_element(formatter, istream, *tc_it, context, 0);
         if (!istream.good())
             return istream;
     }
@@ -1593,7 +2785,8 @@ static StreamType& array_from_stream(
         return istream;
     }
 
-    formatter.parse_suffix(istream);  // fails if serialization too long
+    // fails if serialization too long
+    invoke_parse_suffix(formatter, istream, context, 0);
     if (istream.good())
         c_array_compatible_move_assignment(temp_container, container);
     return istream;
@@ -1609,28 +2802,33 @@ static StreamType& array_from_stream(
 template <typename TupleType, std::size_t Index, std::size_t Last>
 struct tuple_handler
 {
-    template <typename StreamType, typename FormatterType>
+    template <typename StreamType, typename FormatterType, typename ContextType>
     static void parse(
-        StreamType& istream, TupleType& tuple, const FormatterType& formatter)
+        StreamType& istream, TupleType& tuple, const FormatterType& formatter,
+        ContextType& context)
     {
         if (istream.good())
-            formatter.parse_element(istream, std::get<Index>(tuple));
+            invoke_parse_element(
+                formatter, istream, std::get<Index>(tuple), context, 0);
         if (istream.good())
-            formatter.parse_separator(istream);
+            invoke_parse_separator(formatter, istream, context, 0);
         if (istream.good())
-            tuple_handler<TupleType, Index + 1, Last>::parse(istream, tuple, formatter);
+            tuple_handler<TupleType, Index + 1, Last>::parse(
+                istream, tuple, formatter, context);
     }
 };
 
 template <typename TupleType, std::size_t Index>
 struct tuple_handler<TupleType, Index, Index>
 {
-    template <typename StreamType, typename FormatterType>
+    template <typename StreamType, typename FormatterType, typename ContextType>
     static void parse(
-        StreamType& istream, TupleType& tuple, const FormatterType& formatter) noexcept
+        StreamType& istream, TupleType& tuple, const FormatterType& formatter,
+        ContextType& context)
     {
         if (istream.good())
-            formatter.parse_element(istream, std::get<Index>(tuple));
+            invoke_parse_element(
+                formatter, istream, std::get<Index>(tuple), context, 0);
     }
 };
 
@@ -1674,7 +2872,8 @@ static auto emplace_element(ContainerType& container,
 }
 
 /**
- * @brief stream extraction of compatible container type
+ * @brief stream extraction of compatible container type, within the context
+ *   of a top-level call
  * @notes overloads as follows:
  *   - C array
  *   - std::array
@@ -1688,35 +2887,38 @@ static auto emplace_element(ContainerType& container,
  *       traits::is_parseable_as_container)
  */
 template <typename ElementType, std::size_t ArraySize,
-          typename StreamType, typename FormatterType>
+          typename StreamType, typename FormatterType,
+          typename ContextType>
 static StreamType& from_stream(
     StreamType& istream, ElementType (&container)[ArraySize],
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
-    return array_from_stream(istream, container, formatter);
+    return array_from_stream(istream, container, formatter, context);
 }
 
 template <typename ElementType, std::size_t ArraySize,
-          typename StreamType, typename FormatterType>
+          typename StreamType, typename FormatterType,
+          typename ContextType>
 static StreamType& from_stream(
     StreamType& istream, std::array<ElementType, ArraySize>& container,
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
-    return array_from_stream(istream, container, formatter);
+    return array_from_stream(istream, container, formatter, context);
 }
 
-template <typename StreamType, typename FormatterType, typename... TupleArgs>
+template <typename StreamType, typename FormatterType,
+          typename ContextType, typename... TupleArgs>
 static StreamType& from_stream(
     StreamType& istream, std::tuple<TupleArgs...>& container,
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
     using ContainerType = std::decay_t<decltype(container)>;
 
     ContainerType temp;
-    formatter.parse_prefix(istream);
+    invoke_parse_prefix(formatter, istream, context, 0);
     tuple_handler<ContainerType, 0, sizeof...(TupleArgs) - 1
-                  >::parse(istream, temp, formatter);
-    formatter.parse_suffix(istream);
+                  >::parse(istream, temp, formatter, context);
+    invoke_parse_suffix(formatter, istream, context, 0);
     // C arrays not allowed as STL container members due to non-move-
     //   constructiblity, so no need for c_array_compatible_move_assignment
     if (istream.good())
@@ -1724,24 +2926,25 @@ static StreamType& from_stream(
     return istream;
 }
 
-template <typename StreamType, typename FormatterType>
+template <typename StreamType, typename FormatterType, typename ContextType>
 static StreamType& from_stream(
     StreamType& istream, std::tuple<>& /*container*/,
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
     // no contents to parse, only checks if prefix or suffix properly encoded
-    formatter.parse_prefix(istream);
-    formatter.parse_suffix(istream);
+    invoke_parse_prefix(formatter, istream, context, 0);
+    invoke_parse_suffix(formatter, istream, context, 0);
     return istream;
 }
 
 template <typename FirstType, typename SecondType,
-          typename StreamType, typename FormatterType>
+          typename StreamType, typename FormatterType,
+          typename ContextType>
 static StreamType& from_stream(
     StreamType& istream, std::pair<FirstType, SecondType>& container,
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
-    formatter.parse_prefix(istream);
+    invoke_parse_prefix(formatter, istream, context, 0);
     if (!istream.good())
         return istream;
 
@@ -1751,19 +2954,19 @@ static StreamType& from_stream(
     BaseFirstType first;
     SecondType second;
 
-    formatter.parse_element(istream, first);
+    invoke_parse_element(formatter, istream, first, context, 0);
     if (!istream.good())
         return istream;
 
-    formatter.parse_separator(istream);
+    invoke_parse_separator(formatter, istream, context, 0);
     if (!istream.good())
         return istream;
 
-    formatter.parse_element(istream, second);
+    invoke_parse_element(formatter, istream, second, context, 0);
     if (!istream.good())
         return istream;
 
-    formatter.parse_suffix(istream);
+    invoke_parse_suffix(formatter, istream, context, 0);
     if (istream.bad() || istream.fail())
         return istream;
 
@@ -1775,12 +2978,13 @@ static StreamType& from_stream(
     return istream;
 }
 
-template <typename StreamType, typename ElementType, typename FormatterType>
+template <typename StreamType, typename ElementType, typename FormatterType,
+          typename ContextType>
 static StreamType& from_stream(
     StreamType& istream, std::forward_list<ElementType>& container,
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
-    formatter.parse_prefix(istream);
+    invoke_parse_prefix(formatter, istream, context, 0);
     if (!istream.good())
         return istream;
 
@@ -1788,7 +2992,7 @@ static StreamType& from_stream(
     ElementType temp_elem;
 
     // parse suffix to check for empty container
-    formatter.parse_suffix(istream);
+    invoke_parse_suffix(formatter, istream, context, 0);
     if (!istream.bad()) {
         if (!istream.fail()) {
             container.clear();
@@ -1799,7 +3003,7 @@ static StreamType& from_stream(
     }
 
     auto nc_it { new_container.before_begin() };
-    formatter.parse_element(istream, temp_elem);
+    invoke_parse_element(formatter, istream, temp_elem, context, 0);
     if (!istream.good())
         return istream;
     new_container.emplace_after(nc_it, temp_elem);
@@ -1809,7 +3013,7 @@ static StreamType& from_stream(
 
     while (!istream.eof()) {
         // parse suffix first to detect end of serialization
-        formatter.parse_suffix(istream);
+        invoke_parse_suffix(formatter, istream, context, 0);
         if (!istream.bad()) {
             if (!istream.fail())
                 break;
@@ -1817,11 +3021,11 @@ static StreamType& from_stream(
                 istream.clear();
         }
 
-        formatter.parse_separator(istream);
+        invoke_parse_separator(formatter, istream, context, 0);
         if (!istream.good())
             return istream;
 
-        formatter.parse_element(istream, temp_elem);
+        invoke_parse_element(formatter, istream, temp_elem, context, 0);
         if (!istream.good())
             return istream;
         new_container.emplace_after(nc_it, temp_elem);
@@ -1836,12 +3040,13 @@ static StreamType& from_stream(
 }
 
 // TBD use of clear could be avoided with container = ContainerType{}
-template <typename ContainerType, typename StreamType, typename FormatterType>
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename ContextType>
 static StreamType& from_stream(
     StreamType& istream, ContainerType& container,
-    const FormatterType& formatter)
+    const FormatterType& formatter, ContextType& context)
 {
-    formatter.parse_prefix(istream);
+    invoke_parse_prefix(formatter, istream, context, 0);
     if (!istream.good())
         return istream;
 
@@ -1849,7 +3054,7 @@ static StreamType& from_stream(
     typename ContainerType::value_type temp_elem;
 
     // parse suffix to check for empty container
-    formatter.parse_suffix(istream);
+    invoke_parse_suffix(formatter, istream, context, 0);
     if (!istream.bad()) {
         if (!istream.fail()) {
             container.clear();
@@ -1859,14 +3064,14 @@ static StreamType& from_stream(
         }
     }
 
-    formatter.parse_element(istream, temp_elem);
+    invoke_parse_element(formatter, istream, temp_elem, context, 0);
     if (!istream.good())
         return istream;
     emplace_element(new_container, temp_elem);
 
     while (!istream.eof()) {
         // parse suffix first to detect end of serialization
-        formatter.parse_suffix(istream);
+        invoke_parse_suffix(formatter, istream, context, 0);
         if (!istream.bad()) {
             if (!istream.fail())
                 break;
@@ -1874,211 +3079,4191 @@ static StreamType& from_stream(
                 istream.clear();
         }
 
-        formatter.parse_separator(istream);
+        invoke_parse_separator(formatter, istream, context, 0);
+        if (!istream.good())
+            return istream;
+
+        invoke_parse_element(formatter, istream, temp_elem, context, 0);
         if (!istream.good())
             return istream;
+        emplace_element(new_container, temp_elem);
+    }
+
+    // C arrays not allowed as STL container members due to non-move-
+    //   constructiblity, so no need for c_array_compatible_move_assignment
+    if (istream.good())
+        container = std::move(new_container);
+    return istream;
+}
+
+/**
+ * @brief stream extraction of compatible container type, as a top-level call
+ *   creating the context shared by all nesting levels
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static StreamType& from_stream(
+    StreamType& istream, ContainerType& container,
+    const FormatterType& formatter)
+{
+    context<StreamType> call_context { istream };
+    return from_stream(istream, container, formatter, call_context);
+}
+
+/**
+ * @brief walks a container serialization with the same grammar as from_stream
+ *   and the default formatter, without constructing containers or decoded
+ *   strings
+ * @notes
+ *   - check overloads mirror those of from_stream and parse_element, selected
+ *       by a null pointer to the type being validated
+ *   - repr is read from the stream once, at construction
+ */
+template <typename StreamType>
+struct validator
+{
+    using repr_type = strings::detail::repr_type;
+
+    repr_type repr;
+
+    explicit validator(StreamType& istream) :
+        repr { strings::detail::get_repr(istream) }
+    {}
+
+    /**
+     * @brief validates a string representation of char type CharType,
+     *   returning the count of decoded chars
+     */
+    template <typename CharType>
+    std::size_t check_string_repr(StreamType& istream, const CharType delim) const
+    {
+        strings::detail::counting_sink<CharType> sink {};
+        strings::detail::string_repr<const CharType*, CharType> str_repr {
+            nullptr, delim, CharType('\\'), repr };
+        istream >> std::ws;
+        strings::detail::extract_string_repr(istream, str_repr, sink);
+        return sink.size;
+    }
+
+    /**
+     * @brief validates element serializations
+     * @notes overloads as follows:
+     *   - default: non-container, non-string types, extracted into a local as
+     *       there is no way to validate their formatting otherwise
+     *   - CharT
+     *   - basic_string
+     *   - CharT[]
+     */
+    template <typename Type>
+    auto check(StreamType& istream, Type* /*tag*/) const -> std::enable_if_t<
+        !traits::is_char_type<Type>::value &&
+        !traits::is_parseable_as_container<Type>::value,
+        void>
+    {
+        Type temp {};
+        istream >> std::ws >> temp;
+    }
+
+    template <typename Type>
+    auto check(StreamType& istream, Type* /*tag*/) const -> std::enable_if_t<
+        traits::is_char_type<Type>::value,
+        void>
+    {
+        if (check_string_repr(istream, Type('\'')) != 1 && !istream.fail())
+            istream.setstate(std::ios_base::failbit);
+    }
+
+    template <typename CharType>
+    void check(StreamType& istream, std::basic_string<CharType>* /*tag*/) const
+    {
+        check_string_repr(istream, CharType('"'));
+    }
+
+    template <typename CharType, std::size_t ArraySize>
+    auto check(StreamType& istream, CharType (* /*tag*/)[ArraySize]) const
+        -> std::enable_if_t<
+        traits::is_char_type<CharType>::value,
+        void>
+    {
+        if (check_string_repr(istream, CharType('"')) >= ArraySize &&
+            !istream.fail())
+            istream.setstate(std::ios_base::failbit);
+    }
+
+    /**
+     * @brief validates container serializations
+     * @notes overloads as follows:
+     *   - C array
+     *   - std::array
+     *   - std::tuple<T...>
+     *   - std::tuple<>
+     *   - std::pair
+     *   - default: intended for "iterable" STL containers (see
+     *       traits::is_parseable_as_container)
+     */
+    template <typename ElementType, std::size_t ArraySize>
+    auto check(StreamType& istream, ElementType (* /*tag*/)[ArraySize]) const
+        -> std::enable_if_t<
+        !traits::is_char_type<ElementType>::value,
+        void>
+    {
+        check_array<ElementType[ArraySize], ElementType, ArraySize>(istream);
+    }
+
+    template <typename ElementType, std::size_t ArraySize>
+    void check(StreamType& istream,
+               std::array<ElementType, ArraySize>* /*tag*/) const
+    {
+        check_array<std::array<ElementType, ArraySize>,
+                    ElementType, ArraySize>(istream);
+    }
+
+    template <typename... TupleArgs>
+    void check(StreamType& istream, std::tuple<TupleArgs...>* /*tag*/) const
+    {
+        using formatter_type =
+            default_formatter<std::tuple<TupleArgs...>, StreamType>;
+
+        formatter_type::parse_prefix(istream);
+        check_tuple_elements<std::tuple<TupleArgs...>, 0>(istream);
+        formatter_type::parse_suffix(istream);
+    }
+
+    void check(StreamType& istream, std::tuple<>* /*tag*/) const
+    {
+        using formatter_type = default_formatter<std::tuple<>, StreamType>;
+
+        formatter_type::parse_prefix(istream);
+        formatter_type::parse_suffix(istream);
+    }
+
+    template <typename FirstType, typename SecondType>
+    void check(StreamType& istream,
+               std::pair<FirstType, SecondType>* /*tag*/) const
+    {
+        using formatter_type =
+            default_formatter<std::pair<FirstType, SecondType>, StreamType>;
+
+        formatter_type::parse_prefix(istream);
+        if (istream.good())
+            check(istream, static_cast<std::remove_const_t<FirstType>*>(nullptr));
+        if (istream.good())
+            formatter_type::parse_separator(istream);
+        if (istream.good())
+            check(istream, static_cast<SecondType*>(nullptr));
+        if (istream.good())
+            formatter_type::parse_suffix(istream);
+    }
+
+    template <typename ContainerType>
+    auto check(StreamType& istream, ContainerType* /*tag*/) const
+        -> std::enable_if_t<
+        traits::is_parseable_as_container<ContainerType>::value,
+        void>
+    {
+        using formatter_type = default_formatter<ContainerType, StreamType>;
+        using element_type = typename ContainerType::value_type;
+
+        formatter_type::parse_prefix(istream);
+        if (!istream.good())
+            return;
+
+        // parse suffix to check for empty container
+        formatter_type::parse_suffix(istream);
+        if (!istream.bad()) {
+            if (!istream.fail())
+                return;
+            else
+                istream.clear();
+        }
+
+        check(istream, static_cast<element_type*>(nullptr));
+        while (istream.good()) {
+            // parse suffix first to detect end of serialization
+            formatter_type::parse_suffix(istream);
+            if (!istream.bad()) {
+                if (!istream.fail())
+                    break;
+                else
+                    istream.clear();
+            }
+
+            formatter_type::parse_separator(istream);
+            if (istream.good())
+                check(istream, static_cast<element_type*>(nullptr));
+        }
+    }
+
+    /**
+     * @brief helper to C array and std::array overloads of check, validates
+     *   that the serialization has exactly ArraySize elements
+     */
+    template <typename ContainerType, typename ElementType, std::size_t ArraySize>
+    void check_array(StreamType& istream) const
+    {
+        using formatter_type = default_formatter<ContainerType, StreamType>;
+
+        formatter_type::parse_prefix(istream);
+        for (std::size_t i {}; istream.good() && i < ArraySize; ++i)
+        {
+            if (i != 0)
+                formatter_type::parse_separator(istream);
+            if (istream.good())
+                check(istream, static_cast<ElementType*>(nullptr));
+        }
+        // fails if serialization too long or too short
+        if (istream.good())
+            formatter_type::parse_suffix(istream);
+    }
+
+    /**
+     * @brief helper to std::tuple overload of check, validates elements from
+     *   Index to the last
+     * @notes overloads as follows:
+     *   - default
+     *   - last element in tuple
+     */
+    template <typename TupleType, std::size_t Index>
+    auto check_tuple_elements(StreamType& istream) const -> std::enable_if_t<
+        (Index + 1 < std::tuple_size<TupleType>::value),
+        void>
+    {
+        using formatter_type = default_formatter<TupleType, StreamType>;
+        using element_type = typename std::tuple_element<Index, TupleType>::type;
+
+        if (istream.good())
+            check(istream, static_cast<element_type*>(nullptr));
+        if (istream.good())
+            formatter_type::parse_separator(istream);
+        check_tuple_elements<TupleType, Index + 1>(istream);
+    }
+
+    template <typename TupleType, std::size_t Index>
+    auto check_tuple_elements(StreamType& istream) const -> std::enable_if_t<
+        (Index + 1 == std::tuple_size<TupleType>::value),
+        void>
+    {
+        using element_type = typename std::tuple_element<Index, TupleType>::type;
+
+        if (istream.good())
+            check(istream, static_cast<element_type*>(nullptr));
+    }
+};
+
+/**
+ * @brief checks that a serialization of ContainerType could be extracted with
+ *   operator>>, without constructing the container or any of its elements
+ *   (beyond locals for non-container, non-string element types)
+ * @return true if valid, otherwise false with failbit set on stream
+ * @notes as with operator>>, stream is advanced past the serialization
+ */
+template <typename ContainerType, typename StreamType>
+auto validate(StreamType& istream) -> std::enable_if_t<
+    traits::is_parseable_as_container<ContainerType>::value,
+    bool>
+{
+    const validator<StreamType> v { istream };
+    v.check(istream, static_cast<ContainerType*>(nullptr));
+    // eof before the final suffix leaves from_stream without failbit, but also
+    //   without extracting the container
+    if (!istream.good())
+        istream.setstate(std::ios_base::failbit);
+    return !istream.fail();
+}
+
+/**
+ * @brief input iterator that extracts the elements of a serialized container
+ *   from a stream one at a time, rather than materializing the container
+ * @notes
+ *   - similarly to std::istream_iterator, a default constructed iterator acts
+ *       as the end iterator, and iterators compare equal if they are both at
+ *       end or are reading from the same stream
+ *   - construction extracts the prefix and first element, incrementing
+ *       extracts the next separator and element, and reaching the suffix
+ *       makes the iterator equal to end
+ *   - on malformed input the stream is left with failbit set, and the
+ *       iterator becomes equal to end
+ */
+template <typename ContainerType,
+          typename CharType = char,
+          typename TraitsType = std::char_traits<CharType>>
+class istream_container_iterator
+{
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename ContainerType::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+    using istream_type = std::basic_istream<CharType, TraitsType>;
+
+    istream_container_iterator() :
+        istream{nullptr}, element{}
+    {}
+
+    explicit istream_container_iterator(istream_type& is) :
+        istream{&is}, element{}
+    {
+        formatter_type::parse_prefix(*istream);
+        if (!istream->good())
+        {
+            istream = nullptr;
+            return;
+        }
+        // parse suffix to check for empty container
+        if (at_suffix())
+        {
+            istream = nullptr;
+            return;
+        }
+        extract_element();
+    }
+
+    reference operator*() const noexcept
+    {
+        return element;
+    }
+
+    pointer operator->() const noexcept
+    {
+        return &element;
+    }
+
+    istream_container_iterator& operator++()
+    {
+        // parse suffix first to detect end of serialization
+        if (at_suffix())
+        {
+            istream = nullptr;
+            return *this;
+        }
+        formatter_type::parse_separator(*istream);
+        if (!istream->good())
+        {
+            istream = nullptr;
+            return *this;
+        }
+        extract_element();
+        return *this;
+    }
+
+    istream_container_iterator operator++(int)
+    {
+        istream_container_iterator temp { *this };
+        ++*this;
+        return temp;
+    }
+
+    friend bool operator==(const istream_container_iterator& lhs,
+                           const istream_container_iterator& rhs) noexcept
+    {
+        return lhs.istream == rhs.istream;
+    }
+
+    friend bool operator!=(const istream_container_iterator& lhs,
+                           const istream_container_iterator& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    using formatter_type = default_formatter<ContainerType, istream_type>;
+
+    istream_type* istream;
+    value_type element;
+    formatter_type formatter;
+
+    /**
+     * @brief attempts to extract the suffix, restoring stream state if not
+     *   found (as in from_stream)
+     * @return true if suffix was extracted
+     */
+    bool at_suffix()
+    {
+        formatter_type::parse_suffix(*istream);
+        if (istream->bad())
+            return true;
+        if (!istream->fail())
+            return true;
+        istream->clear();
+        return false;
+    }
+
+    /**
+     * @brief extracts the next element with the formatting state the stream
+     *   has at this point, becoming end iterator on failure
+     */
+    void extract_element()
+    {
+        context<istream_type> call_context { *istream };
+        invoke_parse_element(formatter, *istream, element, call_context, 0);
+        if (istream->fail())
+            istream = nullptr;
+    }
+};
+
+/**
+ * @brief single-pass range over the elements of a serialized container, for
+ *   use in range-based for loops
+ * @notes begin() extracts the container prefix, and so should only be called
+ *   once
+ */
+template <typename ContainerType,
+          typename CharType = char,
+          typename TraitsType = std::char_traits<CharType>>
+struct istream_container_range
+{
+    using iterator = istream_container_iterator<ContainerType, CharType, TraitsType>;
+
+    typename iterator::istream_type& istream;
+
+    iterator begin() const
+    {
+        return iterator { istream };
+    }
+
+    iterator end() const
+    {
+        return iterator {};
+    }
+};
+
+/**
+ * @brief generates istream_container_range over the elements of a serialized
+ *   ContainerType in stream
+ */
+template <typename ContainerType, typename CharType, typename TraitsType>
+auto elements_from_stream(std::basic_istream<CharType, TraitsType>& istream
+    ) -> istream_container_range<ContainerType, CharType, TraitsType>
+{
+    return istream_container_range<ContainerType, CharType, TraitsType> { istream };
+}
+
+}  // namespace input
+
+/**
+ * @brief contains an event-driven (SAX-style) parser for container
+ *   serializations, allowing aggregation over serialized containers without
+ *   materializing them
+ */
+namespace sax {
+
+/**
+ * @brief labels for the container grammars recognized by the parser, one per
+ *   specialization of decorator::delimiters
+ */
+enum class container_kind { sequence, set, pair, tuple };
+
+/**
+ * @brief handler with no-op callbacks for every event, intended as a base for
+ *   handlers interested only in some of the events
+ * @notes parse() calls the callbacks of the most derived handler type, so
+ *   derived handlers need only hide the members they are interested in (a
+ *   non-template char_element/string_element overload should be paired with a
+ *   using-declaration of the base template, to still accept other char types)
+ */
+struct null_handler
+{
+    void begin_container(container_kind /*kind*/) {}
+    void end_container(container_kind /*kind*/) {}
+    void integer_element(long long /*value*/) {}
+    void unsigned_element(unsigned long long /*value*/) {}
+    void floating_element(double /*value*/) {}
+
+    template <typename CharType>
+    void char_element(CharType /*value*/) {}
+
+    template <typename CharType>
+    void string_element(const std::basic_string<CharType>& /*value*/) {}
+};
+
+namespace detail {
+
+using repr_type = strings::detail::repr_type;
+
+/**
+ * @brief longest number token accepted, so that memory use stays constant
+ *   regardless of input
+ */
+static constexpr std::size_t max_number_length { 64 };
+
+/**
+ * @brief gets the delimiters for a given container kind
+ * @notes non-specialized delimiters are represented by a C array
+ */
+template <typename CharType>
+static decorator::delim_wrapper<CharType> kind_delimiters(const container_kind kind)
+{
+    switch (kind)
+    {
+    case container_kind::set:
+        return decorator::delimiters<std::set<int>, CharType>::values;
+    case container_kind::pair:
+        return decorator::delimiters<std::pair<int, int>, CharType>::values;
+    case container_kind::tuple:
+        return decorator::delimiters<std::tuple<>, CharType>::values;
+    default:
+        return decorator::delimiters<int[1], CharType>::values;
+    }
+}
+
+/**
+ * @brief finds container kind whose prefix (or suffix) token begins with c
+ * @return true if a matching kind was found
+ */
+template <typename CharType>
+static bool match_kind(const CharType c, const bool match_suffix,
+                       container_kind& kind)
+{
+    static constexpr container_kind kinds[] {
+        container_kind::sequence, container_kind::set,
+        container_kind::pair, container_kind::tuple };
+    for (const auto k : kinds)
+    {
+        const auto decorators { kind_delimiters<CharType>(k) };
+        const CharType* token {
+            match_suffix ? decorators.suffix : decorators.prefix };
+        if (token != nullptr && *token == c)
+        {
+            kind = k;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief decodes a string or char element whose literal prefix has already
+ *   been extracted, and passes it to the handler
+ * @notes buffer is reused between elements to avoid reallocation
+ */
+template <typename StringCharType, typename StreamType, typename HandlerType>
+static void parse_string_element(StreamType& istream, HandlerType& handler,
+                                 const repr_type type,
+                                 std::basic_string<StringCharType>& buffer)
+{
+    using stream_char_type = typename StreamType::char_type;
+
+    // see extract_string_repr
+    if (type == repr_type::quoted &&
+        sizeof(stream_char_type) > sizeof(StringCharType))
+    {
+        istream.setstate(std::ios_base::failbit);
+        return;
+    }
+    const bool is_char {
+        stream_char_type(istream.peek()) == stream_char_type('\'') };
+    buffer.clear();
+    strings::detail::string_repr<std::basic_string<StringCharType>&, StringCharType> repr {
+        buffer, StringCharType(is_char ? '\'' : '"'), StringCharType('\\'), type };
+    strings::detail::extract_delimited_repr(istream, repr, buffer);
+    if (istream.fail())
+        return;
+    if (!is_char)
+        handler.string_element(buffer);
+    else if (buffer.size() == 1)
+        handler.char_element(buffer[0]);
+    else
+        istream.setstate(std::ios_base::failbit);
+}
+
+/**
+ * @brief decodes a number element and passes it to the handler as the
+ *   narrowest of long long, unsigned long long, or double that can hold it
+ */
+template <typename StreamType, typename HandlerType>
+static void parse_number_element(StreamType& istream, HandlerType& handler)
+{
+    using stream_char_type = typename StreamType::char_type;
+
+    const auto separator {
+        kind_delimiters<stream_char_type>(container_kind::sequence).separator };
+    char buff[max_number_length + 1] {};
+    std::size_t length {};
+    bool is_floating {};
+    container_kind kind;
+    for (auto c { istream.peek() };
+         c != StreamType::traits_type::eof(); c = istream.peek())
+    {
+        const stream_char_type sc { stream_char_type(c) };
+        if (sc == *separator || match_kind(sc, true, kind))
+            break;
+        // strtod/strtoll expect char*, and no numeric token is outside ASCII
+        if (c > 0x7f)
+        {
+            istream.setstate(std::ios_base::failbit);
+            return;
+        }
+        if (std::isspace(c))
+            break;
+        if (length == max_number_length)
+        {
+            istream.setstate(std::ios_base::failbit);
+            return;
+        }
+        buff[length++] = char(c);
+        if (std::strchr(".eEnN", char(c)))
+            is_floating = true;
+        istream.get();
+    }
+    if (length == 0)
+    {
+        istream.setstate(std::ios_base::failbit);
+        return;
+    }
+
+    char* end {};
+    errno = 0;
+    if (is_floating)
+    {
+        const double value { std::strtod(buff, &end) };
+        if (end == buff + length && errno == 0)
+            handler.floating_element(value);
+        else
+            istream.setstate(std::ios_base::failbit);
+    }
+    else if (buff[0] == '-')
+    {
+        const long long value { std::strtoll(buff, &end, 10) };
+        if (end == buff + length && errno == 0)
+            handler.integer_element(value);
+        else
+            istream.setstate(std::ios_base::failbit);
+    }
+    else
+    {
+        const unsigned long long value { std::strtoull(buff, &end, 10) };
+        if (end != buff + length || errno != 0)
+            istream.setstate(std::ios_base::failbit);
+        else if (value > static_cast<unsigned long long>(
+                     std::numeric_limits<long long>::max()))
+            handler.unsigned_element(value);
+        else
+            handler.integer_element(static_cast<long long>(value));
+    }
+}
+
+/**
+ * @brief attempts stream extraction of the remainder of a token, after its
+ *   first character has been matched by peek()
+ */
+template <typename StreamType>
+static void extract_matched_token(
+    StreamType& istream, const typename StreamType::char_type* token)
+{
+    using stream_char_type = typename StreamType::char_type;
+
+    for (istream.get(), ++token; *token != stream_char_type('\0'); ++token)
+    {
+        if (stream_char_type(istream.peek()) != *token)
+        {
+            istream.setstate(std::ios_base::failbit);
+            return;
+        }
+        istream.get();
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief parses one serialized container from stream, reporting the start and
+ *   end of each (nested) container and each element to handler as it is
+ *   encountered
+ * @notes
+ *   - string and char elements are decoded as literal or quoted per the
+ *       literalrepr/quotedrepr setting of the stream, and their char type is
+ *       determined by literal prefix
+ *   - memory use is proportional to nesting depth and the longest string
+ *       element, not the size of the serialization
+ *   - on malformed input sets failbit, events already reported are not
+ *       retracted
+ */
+template <typename StreamType, typename HandlerType>
+StreamType& parse(StreamType& istream, HandlerType& handler)
+{
+    using stream_char_type = typename StreamType::char_type;
+    using detail::repr_type;
+
+    const auto type { strings::detail::get_repr(istream) };
+    const auto separator {
+        detail::kind_delimiters<stream_char_type>(container_kind::sequence).separator };
+
+    std::basic_string<char>     buffer;
+    std::basic_string<wchar_t>  wbuffer;
+#if (__cplusplus > 201703L)
+    std::basic_string<char8_t>  u8buffer;
+#endif
+    std::basic_string<char16_t> u16buffer;
+    std::basic_string<char32_t> u32buffer;
+
+    std::vector<container_kind> open_kinds;
+    container_kind kind;
+
+    istream >> std::ws;
+    if (!istream.good() ||
+        !detail::match_kind(stream_char_type(istream.peek()), false, kind))
+    {
+        istream.setstate(std::ios_base::failbit);
+        return istream;
+    }
+
+    do
+    {
+        istream >> std::ws;
+        if (!istream.good())
+            break;
+        const stream_char_type c { stream_char_type(istream.peek()) };
+
+        if (detail::match_kind(c, false, kind))
+        {
+            detail::extract_matched_token(
+                istream, detail::kind_delimiters<stream_char_type>(kind).prefix);
+            if (!istream.good())
+                break;
+            handler.begin_container(kind);
+            open_kinds.push_back(kind);
+            // empty container
+            istream >> std::ws;
+            if (istream.good() &&
+                detail::match_kind(stream_char_type(istream.peek()), true, kind) &&
+                kind == open_kinds.back())
+            {
+                detail::extract_matched_token(
+                    istream, detail::kind_delimiters<stream_char_type>(kind).suffix);
+                handler.end_container(kind);
+                open_kinds.pop_back();
+            }
+            else
+            {
+                continue;
+            }
+        }
+        else if (c == stream_char_type('"') || c == stream_char_type('\''))
+        {
+            detail::parse_string_element(istream, handler, type, buffer);
+        }
+        else if (c == stream_char_type('L'))
+        {
+            istream.get();
+            detail::parse_string_element(istream, handler, type, wbuffer);
+        }
+        else if (c == stream_char_type('u'))
+        {
+            istream.get();
+            if (stream_char_type(istream.peek()) == stream_char_type('8'))
+            {
+#if (__cplusplus > 201703L)
+                istream.get();
+                detail::parse_string_element(istream, handler, type, u8buffer);
+#else
+                istream.setstate(std::ios_base::failbit);
+#endif
+            }
+            else
+            {
+                detail::parse_string_element(istream, handler, type, u16buffer);
+            }
+        }
+        else if (c == stream_char_type('U'))
+        {
+            istream.get();
+            detail::parse_string_element(istream, handler, type, u32buffer);
+        }
+        else
+        {
+            detail::parse_number_element(istream, handler);
+        }
+
+        // close any containers ended by this element, then expect separator
+        while (istream.good() && !open_kinds.empty())
+        {
+            istream >> std::ws;
+            if (!istream.good())
+                break;
+            const stream_char_type next { stream_char_type(istream.peek()) };
+            if (next == *separator)
+            {
+                detail::extract_matched_token(istream, separator);
+                break;
+            }
+            if (!detail::match_kind(next, true, kind) || kind != open_kinds.back())
+            {
+                istream.setstate(std::ios_base::failbit);
+                break;
+            }
+            detail::extract_matched_token(
+                istream, detail::kind_delimiters<stream_char_type>(kind).suffix);
+            if (!istream.good())
+                break;
+            handler.end_container(kind);
+            open_kinds.pop_back();
+        }
+    } while (istream.good() && !open_kinds.empty());
+
+    // eof only acceptable when it follows the final suffix
+    if (!open_kinds.empty())
+        istream.setstate(std::ios_base::failbit);
+    return istream;
+}
+
+}  // namespace sax
+
+/**
+ * @brief contains a structural scanner of container serializations in
+ *   memory, finding the container prefixes, suffixes, and separators outside
+ *   of strings and chars without parsing elements
+ * @notes
+ *   - as with sax, prefixes and suffixes are those of the standard container
+ *       kinds (see sax::container_kind)
+ *   - chars are first classified as candidates (decorator chars, string
+ *       delimiters and escapes) in blocks of 64, using SSE2 or AVX2 where
+ *       available, so that the scanner only visits candidate chars
+ */
+namespace structure {
+
+/**
+ * @brief labels for structural tokens
+ */
+enum class token_type { prefix, suffix, separator };
+
+/**
+ * @brief structural token, with its offset from the start of the scanned
+ *   region
+ */
+struct token
+{
+    token_type type;
+    std::size_t offset;
+};
+
+namespace detail {
+
+/**
+ * @brief count of chars classified at once, one per bit of a block mask
+ */
+static constexpr std::size_t block_size { 64 };
+
+/**
+ * @brief count of candidate chars: four prefixes, four suffixes, separator,
+ *   two string delimiters, and the escape
+ */
+static constexpr std::size_t candidate_count { 12 };
+
+inline unsigned count_trailing_zeros(const std::uint64_t mask) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return unsigned(__builtin_ctzll(mask));
+#else
+    unsigned count {};
+    for (auto m { mask }; (m & 1) == 0; m >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+/**
+ * @brief classifies chars in [block, block + length) as candidates, with
+ *   length at most block_size
+ * @return mask with bit i set if block[i] is a candidate
+ * @notes overloads as follows:
+ *   - default: compares each char with each candidate
+ *   - char: table lookup, or SIMD comparisons of full blocks where available
+ */
+template <typename CharType>
+std::uint64_t classify(const CharType* block, const std::size_t length,
+                       const CharType (&candidates)[candidate_count],
+                       const bool (&/*table*/)[256]) noexcept
+{
+    std::uint64_t mask {};
+    for (std::size_t i {}; i < length; ++i) {
+        for (const auto c : candidates) {
+            if (block[i] == c) {
+                mask |= std::uint64_t(1) << i;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+inline std::uint64_t classify(const char* block, const std::size_t length,
+                              const char (&candidates)[candidate_count],
+                              const bool (&table)[256]) noexcept
+{
+#if defined(__AVX2__)
+    if (length == block_size) {
+        const auto lo { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)) };
+        const auto hi { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)) };
+        auto lo_matches { _mm256_setzero_si256() };
+        auto hi_matches { _mm256_setzero_si256() };
+        for (const auto c : candidates) {
+            const auto broadcast { _mm256_set1_epi8(c) };
+            lo_matches = _mm256_or_si256(lo_matches, _mm256_cmpeq_epi8(lo, broadcast));
+            hi_matches = _mm256_or_si256(hi_matches, _mm256_cmpeq_epi8(hi, broadcast));
+        }
+        return std::uint64_t(std::uint32_t(_mm256_movemask_epi8(lo_matches))) |
+            std::uint64_t(std::uint32_t(_mm256_movemask_epi8(hi_matches))) << 32;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    if (length == block_size) {
+        __m128i chunks[4];
+        __m128i matches[4];
+        for (std::size_t i {}; i < 4; ++i) {
+            chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+            matches[i] = _mm_setzero_si128();
+        }
+        for (const auto c : candidates) {
+            const auto broadcast { _mm_set1_epi8(c) };
+            for (std::size_t i {}; i < 4; ++i)
+                matches[i] = _mm_or_si128(matches[i], _mm_cmpeq_epi8(chunks[i], broadcast));
+        }
+        std::uint64_t mask {};
+        for (std::size_t i {}; i < 4; ++i)
+            mask |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(matches[i]))) << (16 * i);
+        return mask;
+    }
+#else
+    static_cast<void>(candidates);
+#endif
+    std::uint64_t mask {};
+    for (std::size_t i {}; i < length; ++i)
+        mask |= std::uint64_t(table[static_cast<unsigned char>(block[i])]) << i;
+    return mask;
+}
+
+}  // namespace detail
+
+/**
+ * @brief scans a region of memory for structural tokens
+ * @notes
+ *   - separator is the separator token of the containers scanned, eg
+ *       decorator::delimiters<ContainerType, CharType>::values.separator
+ *   - the region and separator must outlive the scanner
+ */
+template <typename CharType>
+class scanner
+{
+public:
+    scanner(const CharType* first, const CharType* last, const CharType* separator) :
+        first_(first), last_(last), separator_(separator),
+        separator_length_(std::char_traits<CharType>::length(separator)),
+        block_(first)
+    {
+        using sax::container_kind;
+        std::size_t i {};
+        for (const auto kind : { container_kind::sequence, container_kind::set,
+                                 container_kind::pair, container_kind::tuple }) {
+            const auto decorators { sax::detail::kind_delimiters<CharType>(kind) };
+            prefixes_[i] = *decorators.prefix;
+            suffixes_[i] = *decorators.suffix;
+            candidates_[2 * i] = prefixes_[i];
+            candidates_[2 * i + 1] = suffixes_[i];
+            ++i;
+        }
+        candidates_[8] = separator_length_ > 0 ? *separator : CharType('\0');
+        candidates_[9] = CharType('"');
+        candidates_[10] = CharType('\'');
+        candidates_[11] = CharType('\\');
+        using unsigned_type = typename std::make_unsigned<CharType>::type;
+        for (const auto c : candidates_) {
+            if (unsigned_type(c) < 256)
+                table_[unsigned_type(c)] = true;
+        }
+        mask_ = classify_block();
+    }
+
+    /**
+     * @brief advances to the next structural token
+     * @return false at the end of the region, or if it ends within a string
+     *   or char (see failed)
+     */
+    bool next(token_type& type, const CharType*& position)
+    {
+        for (const CharType* p { next_candidate() }; p != last_; p = next_candidate()) {
+            const auto c { *p };
+            if (c == CharType('"') || c == CharType('\'')) {
+                if (!skip_string(c))
+                    return false;
+                continue;
+            }
+            // single char separators (all defaults) have no further chars to
+            //   compare or skip
+            if (separator_length_ == 1 && c == *separator_) {
+                type = token_type::separator;
+                position = p;
+                return true;
+            }
+            if (separator_length_ > 1 && c == *separator_ &&
+                std::size_t(last_ - p) >= separator_length_ &&
+                std::char_traits<CharType>::compare(
+                    p, separator_, separator_length_) == 0) {
+                skip_to(p + separator_length_);
+                type = token_type::separator;
+                position = p;
+                return true;
+            }
+            for (std::size_t i {}; i < 4; ++i) {
+                if (c == prefixes_[i] || c == suffixes_[i]) {
+                    type = c == prefixes_[i] ? token_type::prefix : token_type::suffix;
+                    position = p;
+                    return true;
+                }
+            }
+            // escapes outside of strings are left to parsers to reject
+        }
+        return false;
+    }
+
+    /**
+     * @brief tests if the scan ended within a string or char
+     */
+    bool failed() const noexcept
+    {
+        return failed_;
+    }
+
+private:
+    std::uint64_t classify_block() const noexcept
+    {
+        const auto length {
+            std::min(detail::block_size, std::size_t(last_ - block_)) };
+        return detail::classify(block_, length, candidates_, table_);
+    }
+
+    const CharType* next_candidate() noexcept
+    {
+        while (mask_ == 0) {
+            if (std::size_t(last_ - block_) <= detail::block_size) {
+                block_ = last_;
+                return last_;
+            }
+            block_ += detail::block_size;
+            mask_ = classify_block();
+        }
+        const auto i { detail::count_trailing_zeros(mask_) };
+        mask_ &= mask_ - 1;
+        return block_ + i;
+    }
+
+    /**
+     * @brief discards candidates before p
+     */
+    void skip_to(const CharType* p) noexcept
+    {
+        if (p >= last_) {
+            block_ = last_;
+            mask_ = 0;
+            return;
+        }
+        if (std::size_t(p - block_) >= detail::block_size) {
+            block_ = first_ + std::size_t(p - first_) / detail::block_size * detail::block_size;
+            mask_ = classify_block();
+        }
+        const auto offset { unsigned(p - block_) };
+        mask_ &= ~std::uint64_t(0) << offset;
+    }
+
+    /**
+     * @brief skips past the closing delimiter of a string or char, with the
+     *   next candidate being its opening delimiter
+     */
+    bool skip_string(const CharType delim) noexcept
+    {
+        for (const CharType* p { next_candidate() }; p != last_; p = next_candidate()) {
+            if (*p == CharType('\\')) {
+                if (last_ - p < 2)
+                    break;
+                skip_to(p + 2);
+            } else if (*p == delim) {
+                return true;
+            }
+        }
+        failed_ = true;
+        return false;
+    }
+
+    const CharType* first_;
+    const CharType* last_;
+    const CharType* separator_;
+    std::size_t separator_length_;
+    CharType prefixes_[4] {};
+    CharType suffixes_[4] {};
+    CharType candidates_[detail::candidate_count] {};
+    bool table_[256] {};
+    const CharType* block_;
+    std::uint64_t mask_ {};
+    bool failed_ {};
+};
+
+/**
+ * @brief builds structural index of a region of memory, with the offsets of
+ *   all its structural tokens
+ * @return false if the region ends within a string or char
+ */
+template <typename CharType>
+bool index(const CharType* first, const CharType* last, const CharType* separator,
+           std::vector<token>& tokens)
+{
+    scanner<CharType> s { first, last, separator };
+    token_type type;
+    const CharType* position;
+    while (s.next(type, position))
+        tokens.push_back(token { type, std::size_t(position - first) });
+    return !s.failed();
+}
+
+namespace detail {
+
+/**
+ * @brief tests for types parsed by stage two: numeric types, and sequence
+ *   containers (with emplace_back) of such types, nested to any depth
+ */
+template <typename Type, typename = void>
+struct is_indexable : public traits::is_numeric_type<Type>
+{};
+
+template <typename Type>
+struct is_indexable<
+    Type, std::enable_if_t<traits::has_emplace_back<Type>::value &&
+                           traits::is_parseable_as_container<Type>::value>>
+    : public is_indexable<typename Type::value_type>
+{};
+
+/**
+ * @brief tests if stream flags and locale would have operator>> parse
+ *   numbers as parse_number does
+ */
+template <typename StreamType>
+bool has_default_number_format(const StreamType& istream)
+{
+    return (istream.flags() & std::ios_base::basefield) == std::ios_base::dec &&
+        istream.getloc() == std::locale::classic();
+}
+
+/**
+ * @brief tests for whitespace as classified by the classic locale
+ */
+template <typename CharType>
+constexpr bool is_space(const CharType c) noexcept
+{
+    return c == CharType(' ') || c == CharType('\t') || c == CharType('\n') ||
+        c == CharType('\v') || c == CharType('\f') || c == CharType('\r');
+}
+
+template <typename CharType>
+bool is_blank(const CharType* first, const CharType* last) noexcept
+{
+    return std::all_of(first, last, is_space<CharType>);
+}
+
+/**
+ * @brief parses a number from all of [first, last)
+ * @return false if [first, last) is not entirely a number, or if operator>>
+ *   might parse it differently (eg with a leading '+', or out of range), so
+ *   that it can be left to operator>> to parse or reject
+ * @notes overloads as follows:
+ *   - integral types: optional '-' for signed types, then decimal digits
+ *   - floating point types: not parsed
+ *   - floating point types from chars: std::from_chars, where available,
+ *       excluding infinities and NaNs which operator>> does not parse
+ */
+template <typename NumberType, typename CharType>
+auto parse_number(const CharType* first, const CharType* last, NumberType& value
+    ) noexcept -> std::enable_if_t<std::is_integral<NumberType>::value, bool>
+{
+    using unsigned_type = typename std::make_unsigned<NumberType>::type;
+
+    const bool negative {
+        std::is_signed<NumberType>::value && first != last && *first == CharType('-') };
+    if (negative)
+        ++first;
+    if (first == last)
+        return false;
+    const unsigned_type limit { negative ?
+        unsigned_type(unsigned_type(std::numeric_limits<NumberType>::max()) + 1) :
+        unsigned_type(std::numeric_limits<NumberType>::max()) };
+    const unsigned_type max_tens { unsigned_type(limit / 10) };
+    const unsigned_type max_units { unsigned_type(limit % 10) };
+    unsigned_type magnitude {};
+    for (; first != last; ++first) {
+        if (*first < CharType('0') || *first > CharType('9'))
+            return false;
+        const auto digit { unsigned_type(*first - CharType('0')) };
+        if (magnitude > max_tens || (magnitude == max_tens && digit > max_units))
+            return false;
+        magnitude = unsigned_type(magnitude * 10 + digit);
+    }
+    value = negative ?
+        static_cast<NumberType>(unsigned_type(0) - magnitude) :
+        static_cast<NumberType>(magnitude);
+    return true;
+}
+
+template <typename NumberType, typename CharType>
+auto parse_number(const CharType* /*first*/, const CharType* /*last*/,
+                  NumberType& /*value*/
+    ) noexcept -> std::enable_if_t<std::is_floating_point<NumberType>::value, bool>
+{
+    return false;
+}
+
+#ifdef __cpp_lib_to_chars
+template <typename NumberType>
+auto parse_number(const char* first, const char* last, NumberType& value
+    ) noexcept -> std::enable_if_t<std::is_floating_point<NumberType>::value, bool>
+{
+    const char* digits { first != last && *first == '-' ? first + 1 : first };
+    if (digits == last || (*digits != '.' && (*digits < '0' || *digits > '9')))
+        return false;
+    const auto result { std::from_chars(first, last, value) };
+    return result.ec == std::errc {} && result.ptr == last;
+}
+
+#endif  // __cpp_lib_to_chars
+/**
+ * @brief stage two of indexed parsing, extracts indexable containers from a
+ *   region of memory by the structural tokens of a scanner, parsing elements
+ *   from the spans between tokens
+ * @notes
+ *   - expects the default decorators of each container type, with a single
+ *       char prefix and suffix, and the same separator at every depth
+ *   - parse fails on any input that from_stream might not parse the same
+ *       way, rather than setting any stream state, so that callers can fall
+ *       back on from_stream
+ */
+template <typename CharType>
+class indexed_parser
+{
+public:
+    indexed_parser(const CharType* first, const CharType* last,
+                   const CharType* separator) :
+        scanner_(first, last, separator), last_(last), position_(first),
+        separator_(separator),
+        separator_length_(std::char_traits<CharType>::length(separator))
+    {}
+
+    /**
+     * @brief position after the last char parsed
+     */
+    const CharType* position() const noexcept
+    {
+        return position_;
+    }
+
+    /**
+     * @brief parses container from its prefix to its suffix
+     */
+    template <typename ContainerType>
+    bool parse(ContainerType& container)
+    {
+        constexpr decorator::delim_wrapper<CharType> decorators {
+            decorator::delimiters<ContainerType, CharType>::values };
+        if (!has_decorators(decorators))
+            return false;
+
+        token_type type;
+        const CharType* p;
+        if (!peek(type, p) || type != token_type::prefix || *p != *decorators.prefix ||
+            !is_blank(position_, p))
+            return false;
+        consume(p + 1);
+
+        // check for empty container
+        if (!peek(type, p))
+            return false;
+        if (type == token_type::suffix && is_blank(position_, p))
+            return end_container(decorators, p);
+
+        return parse_elements(container, decorators, false);
+    }
+
+    /**
+     * @brief parses elements of ContainerType to the end of the region, which
+     *   holds no prefix or suffix of ContainerType (see
+     *   parallel::detail::parse_chunk)
+     */
+    template <typename ContainerType>
+    bool parse_to_end(std::vector<typename ContainerType::value_type>& elements)
+    {
+        constexpr decorator::delim_wrapper<CharType> decorators {
+            decorator::delimiters<ContainerType, CharType>::values };
+        return has_decorators(decorators) &&
+            parse_elements(elements, decorators, true);
+    }
+
+private:
+    bool has_decorators(const decorator::delim_wrapper<CharType>& decorators) const noexcept
+    {
+        return decorators.prefix_length == 1 && decorators.suffix_length == 1 &&
+            separator_length_ > 0 && decorators.separator_length == separator_length_ &&
+            std::char_traits<CharType>::compare(
+                decorators.separator, separator_, separator_length_) == 0;
+    }
+
+    /**
+     * @brief parses elements up to and including the suffix of their
+     *   container, or up to the end of the region with to_end
+     */
+    template <typename ContainerType>
+    bool parse_elements(ContainerType& container,
+                        const decorator::delim_wrapper<CharType>& decorators,
+                        const bool to_end)
+    {
+        token_type type;
+        const CharType* p;
+        while (true) {
+            typename ContainerType::value_type element;
+            if (!parse_element(element))
+                return false;
+            container.emplace_back(std::move(element));
+
+            if (!peek(type, p)) {
+                if (!to_end || scanner_.failed() || !is_blank(position_, p))
+                    return false;
+                consume(p);
+                return true;
+            }
+            if (!is_blank(position_, p))
+                return false;
+            if (type == token_type::suffix)
+                return !to_end && end_container(decorators, p);
+            if (type != token_type::separator)
+                return false;
+            consume(p + separator_length_);
+        }
+    }
+
+    /**
+     * @brief parses element, up to the next token or end of region
+     * @notes overloads as follows:
+     *   - numeric types: span trimmed of whitespace
+     *   - indexable containers
+     */
+    template <typename ElementType>
+    auto parse_element(ElementType& element) -> std::enable_if_t<
+        traits::is_numeric_type<ElementType>::value,
+        bool>
+    {
+        token_type type;
+        const CharType* p;
+        if (!peek(type, p) && (p != last_ || scanner_.failed()))
+            return false;
+        if (p != last_ && type == token_type::prefix)
+            return false;
+
+        const CharType* first { position_ };
+        const CharType* last { p };
+        while (first != last && is_space(*first))
+            ++first;
+        while (last != first && is_space(*(last - 1)))
+            --last;
+        if (!parse_number(first, last, element))
+            return false;
+        position_ = p;
+        return true;
+    }
+
+    template <typename ElementType>
+    auto parse_element(ElementType& element) -> std::enable_if_t<
+        !traits::is_numeric_type<ElementType>::value,
+        bool>
+    {
+        return parse(element);
+    }
+
+    bool end_container(const decorator::delim_wrapper<CharType>& decorators,
+                       const CharType* p)
+    {
+        if (*p != *decorators.suffix)
+            return false;
+        consume(p + 1);
+        return true;
+    }
+
+    /**
+     * @brief gets the next token without consuming it
+     * @return false at the end of the region, with position at its end
+     */
+    bool peek(token_type& type, const CharType*& position)
+    {
+        if (!has_token_) {
+            if (!scanner_.next(type_, token_)) {
+                position = last_;
+                return false;
+            }
+            has_token_ = true;
+        }
+        type = type_;
+        position = token_;
+        return true;
+    }
+
+    void consume(const CharType* next) noexcept
+    {
+        has_token_ = false;
+        position_ = next;
+    }
+
+    scanner<CharType> scanner_;
+    const CharType* last_;
+    const CharType* position_;
+    const CharType* separator_;
+    std::size_t separator_length_;
+    token_type type_ {};
+    const CharType* token_ {};
+    bool has_token_ {};
+};
+
+}  // namespace detail
+
+/**
+ * @brief stream extraction of compatible container, parsing indexable
+ *   containers directly out of a memory::basic_input_buffer by their
+ *   structural tokens
+ * @notes overloads as follows:
+ *   - indexable containers (sequence containers of numeric types, nested to
+ *       any depth, eg std::vector<std::vector<double>>): the scanner finds the
+ *       decorators of the container in blocks, and its numbers are parsed
+ *       from the spans between them, without any stream extraction
+ *   - default: sequential input::from_stream, as with operator>>
+ * @notes
+ *   - falls back on sequential input::from_stream, as with operator>>, from
+ *       other stream buffers, streams not formatting numbers by default (see
+ *       detail::has_default_number_format), or input that stage two does not
+ *       parse (eg '+' signs, or malformed serializations), so results are
+ *       always the same as with operator>>
+ *   - floating point numbers are only parsed by stage two from char streams
+ *       where std::from_chars is available
+ */
+template <typename ContainerType, typename StreamType>
+auto from_stream(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+    traits::is_parseable_as_container<ContainerType>::value &&
+    traits::has_emplace_back<ContainerType>::value &&
+    detail::is_indexable<ContainerType>::value,
+    StreamType&>
+{
+    using stream_char_type = typename StreamType::char_type;
+    using traits_type = typename StreamType::traits_type;
+    using buffer_type = memory::basic_input_buffer<stream_char_type, traits_type>;
+    using formatter_type = input::default_formatter<ContainerType, StreamType>;
+
+    auto* buffer { dynamic_cast<buffer_type*>(istream.rdbuf()) };
+    if (buffer != nullptr && istream.good() &&
+        detail::has_default_number_format(istream)) {
+        detail::indexed_parser<stream_char_type> parser {
+            buffer->next(), buffer->end(), formatter_type::decorators.separator };
+        ContainerType new_container;
+        if (parser.parse(new_container)) {
+            buffer->set_next(parser.position());
+            container = std::move(new_container);
+            return istream;
+        }
+    }
+    return input::from_stream(istream, container, formatter_type{});
+}
+
+template <typename ContainerType, typename StreamType>
+auto from_stream(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+    traits::is_parseable_as_container<ContainerType>::value &&
+    !(traits::has_emplace_back<ContainerType>::value &&
+      detail::is_indexable<ContainerType>::value),
+    StreamType&>
+{
+    using formatter_type = input::default_formatter<ContainerType, StreamType>;
+    return input::from_stream(istream, container, formatter_type{});
+}
+
+}  // namespace structure
+
+namespace input {
+
+namespace detail {
+
+/**
+ * @brief helper to skip_element, skipping over chars one at a time from any
+ *   stream buffer
+ */
+template <typename CharType, typename TraitsType>
+std::ios_base::iostate skip_chars(std::basic_streambuf<CharType, TraitsType>& buf,
+                                  const CharType separator)
+{
+    CharType prefixes[4];
+    CharType suffixes[4];
+    std::size_t i {};
+    for (const auto kind : { sax::container_kind::sequence, sax::container_kind::set,
+                             sax::container_kind::pair, sax::container_kind::tuple }) {
+        const auto decorators { sax::detail::kind_delimiters<CharType>(kind) };
+        prefixes[i] = *decorators.prefix;
+        suffixes[i] = *decorators.suffix;
+        ++i;
+    }
+
+    std::size_t depth {};
+    for (auto ic { buf.sgetc() }; ; ic = buf.snextc()) {
+        if (TraitsType::eq_int_type(ic, TraitsType::eof()))
+            break;
+        const auto c { TraitsType::to_char_type(ic) };
+        if (c == CharType('"') || c == CharType('\'')) {
+            for (ic = buf.snextc();
+                 !TraitsType::eq_int_type(ic, TraitsType::eof()) &&
+                     TraitsType::to_char_type(ic) != c;
+                 ic = buf.snextc()) {
+                if (TraitsType::to_char_type(ic) == CharType('\\') &&
+                    TraitsType::eq_int_type(buf.snextc(), TraitsType::eof()))
+                    break;
+            }
+            if (TraitsType::eq_int_type(ic, TraitsType::eof()))
+                return std::ios_base::eofbit | std::ios_base::failbit;
+            continue;
+        }
+        if (depth == 0 && c == separator)
+            return std::ios_base::goodbit;
+        if (std::find(std::begin(prefixes), std::end(prefixes), c) !=
+            std::end(prefixes)) {
+            ++depth;
+        } else if (std::find(std::begin(suffixes), std::end(suffixes), c) !=
+                   std::end(suffixes)) {
+            if (depth == 0)
+                return std::ios_base::goodbit;
+            if (--depth == 0) {
+                buf.sbumpc();
+                return std::ios_base::goodbit;
+            }
+        }
+    }
+    return depth > 0 ? std::ios_base::eofbit | std::ios_base::failbit :
+        std::ios_base::eofbit;
+}
+
+/**
+ * @brief helper to skip_element, skipping over a region of memory with
+ *   structure::scanner
+ */
+template <typename CharType, typename TraitsType>
+std::ios_base::iostate skip_region(
+    memory::basic_input_buffer<CharType, TraitsType>& buffer,
+    const CharType* separator)
+{
+    structure::scanner<CharType> scanner { buffer.next(), buffer.end(), separator };
+    std::size_t depth {};
+    structure::token_type type;
+    const CharType* p;
+    while (scanner.next(type, p)) {
+        if (type == structure::token_type::prefix) {
+            ++depth;
+        } else if (depth > 0 && type == structure::token_type::suffix) {
+            if (--depth == 0) {
+                buffer.set_next(p + 1);
+                return std::ios_base::goodbit;
+            }
+        } else if (depth == 0) {
+            buffer.set_next(p);
+            return std::ios_base::goodbit;
+        }
+    }
+    buffer.set_next(buffer.end());
+    return scanner.failed() || depth > 0 ?
+        std::ios_base::eofbit | std::ios_base::failbit : std::ios_base::eofbit;
+}
+
+}  // namespace detail
+
+/**
+ * @brief extracts an element from stream without decoding it, eg for custom
+ *   formatters ignoring some elements
+ * @notes
+ *   - tracks only the nesting depth of containers (by the prefixes and
+ *       suffixes of all container kinds, see sax::container_kind) and skips
+ *       over quoted or literal strings and chars with their escapes, so
+ *       malformed elements are left undetected
+ *   - stops before a separator (by its first char, or whole token for memory
+ *       input buffers) or suffix outside of the element, or after the suffix
+ *       of an element which is a container
+ *   - sets failbit if the stream ends within a string or container, and
+ *       eofbit if the stream ends, as with elements parsed to the end
+ *   - skips the region of memory::basic_input_buffer with structure::scanner
+ */
+template <typename CharType, typename TraitsType>
+std::basic_istream<CharType, TraitsType>& skip_element(
+    std::basic_istream<CharType, TraitsType>& istream, const CharType* separator)
+{
+    istream >> std::ws;
+    if (!istream.good())
+        return istream;
+    if (auto* buffer { dynamic_cast<memory::basic_input_buffer<CharType, TraitsType>*>(
+            istream.rdbuf()) }) {
+        istream.setstate(detail::skip_region(*buffer, separator));
+    } else {
+        istream.setstate(detail::skip_chars(*istream.rdbuf(), *separator));
+    }
+    return istream;
+}
+
+template <typename CharType, typename TraitsType>
+std::basic_istream<CharType, TraitsType>& skip_element(
+    std::basic_istream<CharType, TraitsType>& istream)
+{
+    return skip_element(istream,
+                        decorator::delimiters<void, CharType>::values.separator);
+}
+
+}  // namespace input
+
+/**
+ * @brief contains functions to govern output streaming/insertion of compatible
+ *   containers
+ */
+namespace output {
+
+/**
+ * @brief helper to default_formatter, inserts a decorator token with length
+ *   known at compile time
+ * @notes overloads as follows:
+ *   - default: one write, or formatted insertion if a field width is pending
+ *   - single char: one sputc, unless a field width is pending or the stream
+ *       must be flushed around insertions (tie or unitbuf)
+ */
+template <std::size_t Length, typename StreamType, typename CharType>
+static auto insert_token(StreamType& ostream, const CharType* token
+    ) -> std::enable_if_t<Length != 1, void>
+{
+    if (ostream.width() == 0)
+        ostream.write(token, std::streamsize(Length));
+    else
+        ostream << token;
+}
+
+template <std::size_t Length, typename StreamType, typename CharType>
+static auto insert_token(StreamType& ostream, const CharType* token
+    ) -> std::enable_if_t<Length == 1, void>
+{
+    using traits_type = typename StreamType::traits_type;
+
+    if (ostream.width() != 0 || ostream.tie() != nullptr ||
+        (ostream.flags() & std::ios_base::unitbuf))
+    {
+        ostream << token;
+        return;
+    }
+    if (ostream.good() &&
+        traits_type::eq_int_type(ostream.rdbuf()->sputc(*token), traits_type::eof()))
+        ostream.setstate(std::ios_base::badbit);
+}
+
+/**
+ * @brief state of one top-level to_stream call, shared by all of its nesting
+ *   levels, and passed to formatter hooks which take it as a last parameter
+ */
+template <typename StreamType>
+struct context
+{
+    explicit context(StreamType& ostream) :
+        repr { strings::detail::get_repr(ostream) }
+    {}
+
+    strings::detail::repr_type repr;  // of string and char elements
+    std::size_t depth {};             // of container being printed, 0 at top
+};
+
+/**
+ * @brief default formatter for the printing of decorators and elements in a
+ *   container serialization
+ */
+template <typename ContainerType, typename StreamType>
+struct default_formatter
+{
+    static constexpr auto decorators {
+        decorator::delimiters<ContainerType, typename StreamType::char_type>::values };
+
+    using fused_separator_type = decorator::fused_separator<
+        ContainerType, typename StreamType::char_type>;
+
+    using repr_type = strings::detail::repr_type;
+
+    /**
+     * @brief inserts prefix decorator in stream
+     */
+    static void print_prefix(StreamType& ostream) noexcept
+    {
+        insert_token<decorators.prefix_length>(ostream, decorators.prefix);
+    }
+
+    /**
+     * @brief inserts element in stream
+     * @notes overloads as follows:
+     *   - default
+     *   - char or string types (C or STL)
+     *   - with call context: char or string types, using repr of context
+     *   - with call context: nested containers, printed with the same context
+     */
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) noexcept -> std::enable_if_t<
+            !traits::is_char_type<ElementType>::value &&
+            !traits::is_string_type<ElementType>::value,
+            void>
+    {
+        ostream << element;
+    }
+
+    template<typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) noexcept -> std::enable_if_t<
+            traits::is_char_type<ElementType>::value ||
+            traits::is_string_type<ElementType>::value,
+            void>
+    {
+        print_string(ostream, element, strings::detail::get_repr(ostream));
+    }
+
+    template<typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element,
+                              context<StreamType>& call_context
+        ) noexcept -> std::enable_if_t<
+            traits::is_char_type<ElementType>::value ||
+            traits::is_string_type<ElementType>::value,
+            void>
+    {
+        print_string(ostream, element, call_context.repr);
+    }
+
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element,
+                              context<StreamType>& call_context
+        ) -> std::enable_if_t<
+            traits::is_printable_as_container<ElementType>::value,
+            void>
+    {
+        // unqualified, as to_stream overloads are declared later and found
+        //   by ADL on context
+        ++call_context.depth;
+        to_stream(ostream, element, default_formatter<ElementType, StreamType>{},
+                  call_context);
+        --call_context.depth;
+    }
+
+    /**
+     * @brief inserts separator and whitespace decorators in stream
+     * @notes written as one fused token unless a field width is pending,
+     *   which insertion of the separator must consume
+     */
+    static void print_separator(StreamType& ostream) noexcept
+    {
+        if (ostream.width() == 0)
+            ostream.write(fused_separator_type::value.chars,
+                          std::streamsize(fused_separator_type::length));
+        else
+            ostream << decorators.separator << decorators.whitespace;
+    }
+
+    /**
+     * @brief inserts suffix decorator in stream
+     */
+    static void print_suffix(StreamType& ostream) noexcept
+    {
+        insert_token<decorators.suffix_length>(ostream, decorators.suffix);
+    }
+
+private:
+    template<typename ElementType>
+    static void print_string(StreamType& ostream, const ElementType& element,
+                             const repr_type repr) noexcept
+    {
+        if (repr == repr_type::quoted)
+            ostream << strings::quoted(element);
+        else
+            ostream << strings::detail::with_type(strings::literal(element), repr);
+    }
+};
+
+/**
+ * @brief helpers to to_stream, invoke formatter hooks with the call context
+ *   if they take it as a last parameter, or without it otherwise
+ */
+template <typename FormatterType, typename StreamType, typename ContextType>
+static auto invoke_print_prefix(const FormatterType& formatter, StreamType& ostream,
+                                ContextType& context, int
+    ) -> decltype(formatter.print_prefix(ostream, context), void())
+{
+    formatter.print_prefix(ostream, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static void invoke_print_prefix(const FormatterType& formatter, StreamType& ostream,
+                                ContextType& /*context*/, long)
+{
+    formatter.print_prefix(ostream);
+}
+
+template <typename FormatterType, typename StreamType, typename ElementType,
+          typename ContextType>
+static auto invoke_print_element(const FormatterType& formatter, StreamType& ostream,
+                                 const ElementType& element, ContextType& context, int
+    ) -> decltype(formatter.print_element(ostream, element, context), void())
+{
+    formatter.print_element(ostream, element, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ElementType,
+          typename ContextType>
+static void invoke_print_element(const FormatterType& formatter, StreamType& ostream,
+                                 const ElementType& element, ContextType& /*context*/,
+                                 long)
+{
+    formatter.print_element(ostream, element);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static auto invoke_print_separator(const FormatterType& formatter, StreamType& ostream,
+                                   ContextType& context, int
+    ) -> decltype(formatter.print_separator(ostream, context), void())
+{
+    formatter.print_separator(ostream, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static void invoke_print_separator(const FormatterType& formatter, StreamType& ostream,
+                                   ContextType& /*context*/, long)
+{
+    formatter.print_separator(ostream);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static auto invoke_print_suffix(const FormatterType& formatter, StreamType& ostream,
+                                ContextType& context, int
+    ) -> decltype(formatter.print_suffix(ostream, context), void())
+{
+    formatter.print_suffix(ostream, context);
+}
+
+template <typename FormatterType, typename StreamType, typename ContextType>
+static void invoke_print_suffix(const FormatterType& formatter, StreamType& ostream,
+                                ContextType& /*context*/, long)
+{
+    formatter.print_suffix(ostream);
+}
+
+/**
+ * @brief helper to to_stream(tuple), recursive struct meant to unpack and
+ *   parse std::tuple elements
+ * @notes overloads as follows:
+ *   - default
+ *   - last element in tuple
+ */
+template <typename TupleType, std::size_t Index, std::size_t Last>
+struct tuple_handler
+{
+    template <typename StreamType, typename FormatterType, typename ContextType>
+    static void print(
+        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter,
+        ContextType& context)
+    {
+        invoke_print_element(formatter, ostream, std::get<Index>(tuple), context, 0);
+        invoke_print_separator(formatter, ostream, context, 0);
+        tuple_handler<TupleType, Index + 1, Last>::print(
+            ostream, tuple, formatter, context);
+    }
+};
+
+template <typename TupleType, std::size_t Index>
+struct tuple_handler<TupleType, Index, Index>
+{
+    template <typename StreamType, typename FormatterType, typename ContextType>
+    static void print(
+        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter,
+        ContextType& context)
+    {
+        invoke_print_element(formatter, ostream, std::get<Index>(tuple), context, 0);
+    }
+};
+
+/**
+ * @brief helper to print_elements, prints container elements one at a time
+ *   using formatter
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename ContextType>
+static void print_each_element(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, ContextType& context)
+{
+    auto begin = std::begin(container);
+    invoke_print_element(formatter, ostream, *begin, context, 0);
+
+    std::advance(begin, 1);
+
+    std::for_each(begin, std::end(container),
+#ifdef __cpp_generic_lambdas
+                  [&ostream, &formatter, &context](const auto& element) {
+#else
+                  [&ostream, &formatter, &context](const decltype(*begin)& element) {
+#endif
+        invoke_print_separator(formatter, ostream, context, 0);
+        invoke_print_element(formatter, ostream, element, context, 0);
+    });
+}
+
+/**
+ * @brief longest formatting of a single number produced by format_number,
+ *   longer formattings (eg std::fixed with large values) are left to the
+ *   stream
+ */
+static constexpr std::size_t max_number_length { 64 };
+
+/**
+ * @brief helper to print_contiguous_numeric_elements, tests if stream flags and
+ *   locale would have operator<< format numbers as format_number does
+ */
+template <typename StreamType>
+static bool has_default_number_format(const StreamType& ostream)
+{
+    const auto flags { ostream.flags() };
+    const auto basefield { flags & std::ios_base::basefield };
+    const auto floatfield { flags & std::ios_base::floatfield };
+    return !(flags & (std::ios_base::showbase | std::ios_base::showpos |
+                      std::ios_base::showpoint | std::ios_base::uppercase)) &&
+        basefield != std::ios_base::oct && basefield != std::ios_base::hex &&
+        floatfield != (std::ios_base::fixed | std::ios_base::scientific) &&
+        ostream.precision() >= 0 &&
+        ostream.getloc() == std::locale::classic();
+}
+
+/**
+ * @brief helper to print_contiguous_numeric_elements, formats a number into
+ *   [first, last) as operator<< would with default flags
+ * @return count of chars written, or 0 if number could not be formatted in
+ *   the space given
+ * @notes overloads as follows:
+ *   - integral types
+ *   - floating point types (only when std::to_chars is available, as unlike
+ *       snprintf it does not depend on the C locale)
+ */
+template <typename NumberType>
+static auto format_number(char* first, char* last, const NumberType value,
+                          const std::ios_base& /*ios*/) noexcept
+    -> std::enable_if_t<std::is_integral<NumberType>::value, std::size_t>
+{
+    using unsigned_type = typename std::make_unsigned<NumberType>::type;
+
+    char digits[std::numeric_limits<unsigned_type>::digits10 + 1];
+    char* d { std::end(digits) };
+    const bool negative { value < 0 };
+    unsigned_type magnitude { negative ?
+        static_cast<unsigned_type>(0 - static_cast<unsigned_type>(value)) :
+        static_cast<unsigned_type>(value) };
+    do {
+        *--d = char('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    const std::size_t length {
+        std::size_t(std::end(digits) - d) + (negative ? 1 : 0) };
+    if (length > std::size_t(last - first))
+        return 0;
+    if (negative)
+        *first++ = '-';
+    std::copy(d, std::end(digits), first);
+    return length;
+}
+
+template <typename NumberType>
+static auto format_number(char* first, char* last, const NumberType value,
+                          const std::ios_base& ios) noexcept
+    -> std::enable_if_t<std::is_floating_point<NumberType>::value, std::size_t>
+{
+#ifdef __cpp_lib_to_chars
+    const auto floatfield { ios.flags() & std::ios_base::floatfield };
+    const std::chars_format format {
+        floatfield == std::ios_base::fixed ? std::chars_format::fixed :
+        floatfield == std::ios_base::scientific ? std::chars_format::scientific :
+                                                  std::chars_format::general };
+    const auto result {
+        std::to_chars(first, last, value, format, int(ios.precision())) };
+    if (result.ec != std::errc {})
+        return 0;
+    return std::size_t(result.ptr - first);
+#else
+    static_cast<void>(first);
+    static_cast<void>(last);
+    static_cast<void>(value);
+    static_cast<void>(ios);
+    return 0;
+#endif  // __cpp_lib_to_chars
+}
+
+/**
+ * @brief helper to print_elements, formats numeric elements in blocks into a
+ *   local buffer, writing each block to the stream buffer with one sputn
+ *   rather than inserting each element and separator individually
+ * @notes takes a pointer and size rather than a container so that ranges of
+ *   elements can also be printed (see parallel::to_stream)
+ */
+template <typename FormatterType, typename NumberType, typename StreamType>
+static void print_contiguous_numeric_elements(
+    StreamType& ostream, const NumberType* data, const std::size_t size)
+{
+    using stream_char_type = typename StreamType::char_type;
+    using formatter_type = FormatterType;
+
+    static constexpr std::size_t block_size { 1024 };
+
+    // sentry lookup via StreamType would be ambiguous for iostreams
+    const typename std::basic_ostream<
+        stream_char_type, typename StreamType::traits_type>::sentry sentry { ostream };
+    if (!sentry)
+        return;
+
+    using fused_type = typename formatter_type::fused_separator_type;
+    const stream_char_type* separator { fused_type::value.chars };
+    const std::size_t separator_length { fused_type::length };
+    if (separator_length > block_size / 2)
+    {
+        for (std::size_t i {}; i < size; ++i)
+        {
+            if (i != 0)
+                formatter_type::print_separator(ostream);
+            formatter_type::print_element(ostream, data[i]);
+        }
+        return;
+    }
+
+    stream_char_type block[block_size];
+    std::size_t block_length {};
+    auto flush_block = [&ostream, &block, &block_length]() {
+        if (ostream.rdbuf()->sputn(block, std::streamsize(block_length)) !=
+            std::streamsize(block_length))
+            ostream.setstate(std::ios_base::badbit);
+        block_length = 0;
+    };
+
+    char number[max_number_length];
+    for (std::size_t i {}; i < size && ostream.good(); ++i)
+    {
+        if (block_size - block_length < separator_length + max_number_length)
+            flush_block();
+        if (i != 0)
+        {
+            std::copy(separator, separator + separator_length,
+                      block + block_length);
+            block_length += separator_length;
+        }
+        const std::size_t length {
+            format_number(number, number + max_number_length, data[i], ostream) };
+        if (length == 0)
+        {
+            // leave formatting to stream
+            flush_block();
+            ostream << data[i];
+            continue;
+        }
+        for (std::size_t j {}; j < length; ++j)
+            block[block_length++] = stream_char_type(number[j]);
+    }
+    if (ostream.good())
+        flush_block();
+}
+
+/**
+ * @brief helper to to_stream, prints elements of a non-empty container
+ * @notes overloads as follows:
+ *   - default: print_each_element
+ *   - contiguous containers of numeric types printed with the default
+ *       formatter: print_contiguous_numeric_elements, if stream formatting
+ *       state allows
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename ContextType>
+static auto print_elements(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, ContextType& context) -> std::enable_if_t<
+        !traits::is_contiguous_numeric_container<ContainerType>::value ||
+        !std::is_same<FormatterType,
+                      default_formatter<ContainerType, StreamType>>::value,
+        void>
+{
+    print_each_element(ostream, container, formatter, context);
+}
+
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename ContextType>
+static auto print_elements(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, ContextType& context) -> std::enable_if_t<
+        traits::is_contiguous_numeric_container<ContainerType>::value &&
+        std::is_same<FormatterType,
+                     default_formatter<ContainerType, StreamType>>::value,
+        void>
+{
+    if (has_default_number_format(ostream))
+        print_contiguous_numeric_elements<FormatterType>(
+            ostream, traits::contiguous_data(container),
+            traits::contiguous_size(container));
+    else
+        print_each_element(ostream, container, formatter, context);
+}
+
+/**
+ * @brief stream insertion of compatible container type, within the context
+ *   of a top-level call
+ * @notes overloads as follows:
+ *   - std::tuple<T...>
+ *   - std::tuple<>
+ *   - std::pair
+ *   - C++20 ranges (see traits::is_printable_as_range)
+ *   - default: intended for "iterable" STL containers (see
+ *       traits::is_printable_as_container)
+ */
+template <typename StreamType, typename FormatterType, typename ContextType,
+          typename... TupleArgs>
+static StreamType& to_stream(
+    StreamType& ostream, const std::tuple<TupleArgs...>& tuple,
+    const FormatterType& formatter, ContextType& context)
+{
+    using TupleType = std::decay_t<decltype(tuple)>;
+
+    invoke_print_prefix(formatter, ostream, context, 0);
+    container_stream_io::output::tuple_handler<
+        TupleType, 0, sizeof...(TupleArgs) - 1>::print(
+            ostream, tuple, formatter, context);
+    invoke_print_suffix(formatter, ostream, context, 0);
+
+    return ostream;
+}
+
+template <typename StreamType, typename FormatterType, typename ContextType>
+static StreamType& to_stream(
+    StreamType& ostream, const std::tuple<>& /*tuple*/,
+    const FormatterType& formatter, ContextType& context)
+{
+    invoke_print_prefix(formatter, ostream, context, 0);
+    invoke_print_suffix(formatter, ostream, context, 0);
+    return ostream;
+}
+
+template <typename FirstType, typename SecondType, typename StreamType,
+          typename FormatterType, typename ContextType>
+static StreamType& to_stream(
+    StreamType& ostream, const std::pair<FirstType, SecondType>& container,
+    const FormatterType& formatter, ContextType& context)
+{
+    invoke_print_prefix(formatter, ostream, context, 0);
+    invoke_print_element(formatter, ostream, container.first, context, 0);
+    invoke_print_separator(formatter, ostream, context, 0);
+    invoke_print_element(formatter, ostream, container.second, context, 0);
+    invoke_print_suffix(formatter, ostream, context, 0);
+
+    return ostream;
+}
+
+#ifdef __cpp_lib_ranges
+/**
+ * @brief helper to to_stream(range), prints elements of a range that may have
+ *   a sentinel type differing from its iterator type
+ */
+template <typename RangeType, typename StreamType, typename FormatterType,
+          typename ContextType>
+static void print_range(
+    StreamType& ostream, RangeType&& range, const FormatterType& formatter,
+    ContextType& context)
+{
+    invoke_print_prefix(formatter, ostream, context, 0);
+
+    auto it = std::ranges::begin(range);
+    const auto end = std::ranges::end(range);
+    if (it != end) {
+        invoke_print_element(formatter, ostream, *it, context, 0);
+        for (++it; it != end; ++it) {
+            invoke_print_separator(formatter, ostream, context, 0);
+            invoke_print_element(formatter, ostream, *it, context, 0);
+        }
+    }
+
+    invoke_print_suffix(formatter, ostream, context, 0);
+}
+
+template <typename RangeType, typename StreamType, typename FormatterType,
+          typename ContextType>
+    requires traits::is_printable_as_range<RangeType>::value
+static StreamType& to_stream(
+    StreamType& ostream, const RangeType& range,
+    const FormatterType& formatter, ContextType& context)
+{
+    if constexpr (std::ranges::input_range<const RangeType>) {
+        print_range(ostream, range, formatter, context);
+    } else {
+        // views are cheap to copy by definition
+        RangeType view { range };
+        print_range(ostream, view, formatter, context);
+    }
+
+    return ostream;
+}
+
+#endif  // __cpp_lib_ranges
+template <typename ContainerType, typename StreamType, typename FormatterType,
+          typename ContextType>
+static StreamType& to_stream(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter, ContextType& context)
+{
+    invoke_print_prefix(formatter, ostream, context, 0);
+
+    if (container_stream_io::traits::is_empty(container)) {
+        invoke_print_suffix(formatter, ostream, context, 0);
+
+        return ostream;
+    }
+
+    print_elements(ostream, container, formatter, context);
+
+    invoke_print_suffix(formatter, ostream, context, 0);
+
+    return ostream;
+}
+
+/**
+ * @brief stream insertion of compatible container type, as a top-level call
+ *   creating the context shared by all nesting levels
+ */
+template <typename ContainerType, typename StreamType, typename FormatterType>
+static StreamType& to_stream(
+    StreamType& ostream, const ContainerType& container,
+    const FormatterType& formatter)
+{
+    context<StreamType> call_context { ostream };
+    return to_stream(ostream, container, formatter, call_context);
+}
+
+}  // namespace output
+
+/**
+ * @brief contains a compact binary serialization format for compatible
+ *   containers, as an alternative pair of formatters to the default text
+ *   formatters of input and output
+ * @notes format:
+ *   - containers other than std::pair and std::tuple are prefixed with their
+ *       element count, as an unsigned 64-bit little-endian integer
+ *   - arithmetic values (including char types) are stored as their object
+ *       representation in little-endian byte order, bool as a single 0 or 1
+ *       byte, and long double as its precision, class, exponent and
+ *       significand (see write_long_double)
+ *   - strings (STL strings and string views, C char arrays) are stored as a
+ *       length in code units, as for container element counts, followed by
+ *       the code units, as with arithmetic values
+ *   - no decorators, separators, or padding are used
+ *   - with integer_encoding::varint, element counts, string lengths, and
+ *       integers wider than one byte (other than chars and bool) are instead
+ *       stored as LEB128 varints, zigzag encoded for signed types
+ */
+namespace binary {
+
+/**
+ * @brief labels for integer encoding flag values
+ */
+enum class integer_encoding { fixed, varint };
+
+template <typename ContainerType, typename StreamType,
+          integer_encoding Encoding = integer_encoding::fixed>
+struct output_formatter;
+
+template <typename ContainerType, typename StreamType,
+          integer_encoding Encoding = integer_encoding::fixed>
+struct input_formatter;
+
+namespace detail {
+
+/**
+ * @brief stream index getter for use with iword to set fixedint/varint
+ */
+static inline int get_manip_i()
+{
+    static int i {std::ios_base::xalloc()};
+    return i;
+}
+
+/**
+ * @brief type used to encode container element counts and string lengths
+ */
+using length_type = std::uint64_t;
+
+/**
+ * @brief maps an object size to the unsigned integer type of the same size,
+ *   used to reorder the bytes of arithmetic values
+ */
+template <std::size_t Size>
+struct unsigned_of_size
+{};
+
+template <>
+struct unsigned_of_size<1>
+{
+    using type = std::uint8_t;
+};
+
+template <>
+struct unsigned_of_size<2>
+{
+    using type = std::uint16_t;
+};
+
+template <>
+struct unsigned_of_size<4>
+{
+    using type = std::uint32_t;
+};
+
+template <>
+struct unsigned_of_size<8>
+{
+    using type = std::uint64_t;
+};
+
+/**
+ * @brief tests for arithmetic types that can be encoded, excluding bool and
+ *   long double which are encoded separately
+ */
+template <typename Type>
+struct is_encodable_arithmetic : public std::integral_constant<
+    bool,
+    std::is_arithmetic<Type>::value && !std::is_same<Type, bool>::value &&
+    !std::is_same<Type, long double>::value>
+{};
+
+/**
+ * @brief tests for integral types stored as varints with
+ *   integer_encoding::varint, excluding chars, bool, and single byte types,
+ *   which varints cannot shrink
+ */
+template <typename Type>
+struct is_varint_type : public std::integral_constant<
+    bool,
+    std::is_integral<Type>::value && traits::is_numeric_type<Type>::value>
+{};
+
+/**
+ * @brief tests for containers serialized with a fixed number of elements, and
+ *   thus without an element count
+ */
+template <typename Type>
+struct is_fixed_arity : public std::false_type
+{};
+
+template <typename FirstType, typename SecondType>
+struct is_fixed_arity<std::pair<FirstType, SecondType>> : public std::true_type
+{};
+
+template <typename... Args>
+struct is_fixed_arity<std::tuple<Args...>> : public std::true_type
+{};
+
+/**
+ * @brief tests for containers with member size(), used as their element count
+ */
+template <typename Type, typename = void>
+struct has_size : public std::false_type
+{};
+
+template <typename Type>
+struct has_size<
+    Type, std::void_t<decltype(std::size_t(std::declval<const Type&>().size()))>>
+    : public std::true_type
+{};
+
+/**
+ * @brief tests for containers with const forward iterators, whose elements
+ *   can be counted before they are written without consuming them
+ */
+template <typename Type, typename = void>
+struct has_forward_iterator : public std::false_type
+{};
+
+template <typename Type>
+struct has_forward_iterator<
+    Type, std::void_t<typename std::iterator_traits<decltype(
+              std::begin(std::declval<const Type&>()))>::iterator_category>>
+    : public std::is_base_of<
+        std::forward_iterator_tag,
+        typename std::iterator_traits<decltype(
+            std::begin(std::declval<const Type&>()))>::iterator_category>
+{};
+
+/**
+ * @brief tests for C++20 forward ranges, including views only iterable when
+ *   non-const (eg std::views::filter), which are counted through a copy
+ */
+template <typename Type>
+struct is_forward_range : public std::integral_constant<
+    bool,
+#ifdef __cpp_lib_ranges
+    std::ranges::forward_range<const Type> ||
+    (std::ranges::view<Type> && std::ranges::forward_range<Type>)
+#else
+    false
+#endif
+    >
+{};
+
+/**
+ * @brief tests for containers which can only be iterated once (eg
+ *   std::views::istream), and so are buffered to count their elements
+ */
+template <typename Type>
+struct is_single_pass : public std::integral_constant<
+    bool,
+    !is_fixed_arity<Type>::value && !std::is_array<Type>::value &&
+    !has_size<Type>::value && !has_forward_iterator<Type>::value &&
+    !is_forward_range<Type>::value>
+{};
+
+/**
+ * @brief tests for std::vectors of varint types, which are read and written
+ *   in batches with integer_encoding::varint
+ */
+template <typename Type, integer_encoding Encoding>
+struct is_batched_varint_container : public std::false_type
+{};
+
+template <typename ElementType, typename AllocType>
+struct is_batched_varint_container<std::vector<ElementType, AllocType>,
+                                   integer_encoding::varint>
+    : public std::integral_constant<bool, is_varint_type<ElementType>::value>
+{};
+
+/**
+ * @brief true on hosts storing arithmetic values in little-endian byte order,
+ *   where their object representation is already in binary format
+ */
+static constexpr bool native_little_endian {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#elif defined(_WIN32)
+    true
+#else
+    false
+#endif
+};
+
+/**
+ * @brief tests for element types that can be copied to and from streams as
+ *   raw bytes, being stored in their native object representation
+ */
+template <typename Type, integer_encoding Encoding>
+struct is_bulk_element : public std::integral_constant<
+    bool,
+    native_little_endian && is_encodable_arithmetic<Type>::value &&
+    (sizeof(Type) <= sizeof(std::uint64_t)) &&
+    (Encoding == integer_encoding::fixed || !is_varint_type<Type>::value)>
+{};
+
+/**
+ * @brief tests for contiguous containers of bulk elements, which are read and
+ *   written with a single sgetn/sputn of all of their elements
+ * @notes overloads as follows:
+ *   - base case: all incompatible types excluded
+ *   - std::vector
+ *   - std::array
+ *   - C array
+ */
+template <typename Type, integer_encoding Encoding>
+struct is_bulk_container : public std::false_type
+{};
+
+template <typename ElementType, typename AllocType, integer_encoding Encoding>
+struct is_bulk_container<std::vector<ElementType, AllocType>, Encoding>
+    : public is_bulk_element<ElementType, Encoding>
+{};
+
+template <typename ElementType, std::size_t ArraySize, integer_encoding Encoding>
+struct is_bulk_container<std::array<ElementType, ArraySize>, Encoding>
+    : public is_bulk_element<ElementType, Encoding>
+{};
+
+template <typename ElementType, std::size_t ArraySize, integer_encoding Encoding>
+struct is_bulk_container<ElementType[ArraySize], Encoding>
+    : public is_bulk_element<ElementType, Encoding>
+{};
+
+/**
+ * @brief encodes value as little-endian bytes at out
+ */
+template <typename ValueType>
+void encode(const ValueType value, char* out) noexcept
+{
+    using unsigned_type = typename unsigned_of_size<sizeof(ValueType)>::type;
+    static_assert(!std::is_floating_point<ValueType>::value ||
+                  std::numeric_limits<ValueType>::is_iec559,
+                  "binary format requires IEC 559 floating point types");
+
+    unsigned_type u;
+    std::memcpy(&u, &value, sizeof(u));
+    for (std::size_t i {}; i < sizeof(u); ++i)
+        out[i] = static_cast<char>((u >> (8 * i)) & 0xff);
+}
+
+/**
+ * @brief decodes value from little-endian bytes at in
+ */
+template <typename ValueType>
+ValueType decode(const char* in) noexcept
+{
+    using unsigned_type = typename unsigned_of_size<sizeof(ValueType)>::type;
+
+    unsigned_type u {};
+    for (std::size_t i {}; i < sizeof(u); ++i)
+        u = static_cast<unsigned_type>(
+            u | unsigned_type(static_cast<unsigned char>(in[i])) << (8 * i));
+    ValueType value;
+    std::memcpy(&value, &u, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief writes bytes directly to stream buffer, setting badbit on short writes
+ */
+template <typename StreamType>
+void write_bytes(StreamType& ostream, const char* bytes, const std::size_t count)
+{
+    static_assert(std::is_same<typename StreamType::char_type, char>::value,
+                  "binary format requires streams of char");
+    if (!ostream.good())
+        return;
+    if (ostream.rdbuf()->sputn(bytes, std::streamsize(count)) !=
+        std::streamsize(count))
+        ostream.setstate(std::ios_base::badbit);
+}
+
+/**
+ * @brief reads bytes directly from stream buffer, setting eofbit and failbit
+ *   on short reads
+ * @notes bypasses the istream sentry, which would otherwise skip "whitespace"
+ *   bytes
+ */
+template <typename StreamType>
+bool read_bytes(StreamType& istream, char* bytes, const std::size_t count)
+{
+    static_assert(std::is_same<typename StreamType::char_type, char>::value,
+                  "binary format requires streams of char");
+    if (!istream.good())
+        return false;
+    if (istream.rdbuf()->sgetn(bytes, std::streamsize(count)) !=
+        std::streamsize(count))
+    {
+        istream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+        return false;
+    }
+    return true;
+}
+
+template <typename StreamType, typename ValueType>
+void write_value(StreamType& ostream, const ValueType value)
+{
+    char bytes[sizeof(ValueType)];
+    encode(value, bytes);
+    write_bytes(ostream, bytes, sizeof(bytes));
+}
+
+template <typename StreamType, typename ValueType>
+bool read_value(StreamType& istream, ValueType& value)
+{
+    char bytes[sizeof(ValueType)];
+    if (!read_bytes(istream, bytes, sizeof(bytes)))
+        return false;
+    value = decode<ValueType>(bytes);
+    return true;
+}
+
+/**
+ * @brief labels for the class byte of long double values, with the sign in
+ *   its high bit
+ */
+enum class long_double_class : std::uint8_t { zero, finite, infinity, nan };
+
+static constexpr std::uint8_t long_double_sign { 0x80 };
+
+/**
+ * @brief writes or reads long double values in full, as the precision of the
+ *   host (std::numeric_limits<long double>::digits, one byte), the class
+ *   byte, the binary exponent (32-bit), and the integral significand (as two
+ *   64-bit halves, high first)
+ * @notes
+ *   - independent of the width and layout of long double (eg x87 extended
+ *       precision, IEC 559 binary128, or the same as double), but reading
+ *       fails on hosts of a different precision, rather than losing digits
+ *   - NaN payloads are not kept
+ */
+template <typename StreamType>
+void write_long_double(StreamType& ostream, const long double value)
+{
+    using limits = std::numeric_limits<long double>;
+    static_assert(limits::is_iec559 && limits::digits <= 128,
+                  "binary format requires IEC 559 long double");
+
+    auto kind { std::isnan(value) ? long_double_class::nan :
+                std::isinf(value) ? long_double_class::infinity :
+                value == 0 ? long_double_class::zero :
+                             long_double_class::finite };
+    int exponent {};
+    long double high {};
+    long double low {};
+    if (kind == long_double_class::finite)
+    {
+        const auto significand { std::ldexp(
+            std::frexp(std::fabs(value), &exponent), limits::digits) };
+        high = std::floor(std::ldexp(significand, -64));
+        low = significand - std::ldexp(high, 64);
+    }
+    write_value(ostream, std::uint8_t(limits::digits));
+    write_value(ostream, std::uint8_t(std::uint8_t(kind) |
+                                      (std::signbit(value) ? long_double_sign : 0)));
+    write_value(ostream, std::int32_t(exponent));
+    write_value(ostream, std::uint64_t(high));
+    write_value(ostream, std::uint64_t(low));
+}
+
+template <typename StreamType>
+bool read_long_double(StreamType& istream, long double& value)
+{
+    using limits = std::numeric_limits<long double>;
+
+    std::uint8_t digits;
+    std::uint8_t kind;
+    std::int32_t exponent;
+    std::uint64_t high;
+    std::uint64_t low;
+    if (!read_value(istream, digits) || !read_value(istream, kind) ||
+        !read_value(istream, exponent) || !read_value(istream, high) ||
+        !read_value(istream, low))
+        return false;
+    if (digits != limits::digits)
+    {
+        istream.setstate(std::ios_base::failbit);
+        return false;
+    }
+    long double magnitude {};
+    switch (long_double_class(kind & ~long_double_sign))
+    {
+    case long_double_class::zero:
+        break;
+    case long_double_class::finite:
+        magnitude = std::ldexp(std::ldexp(static_cast<long double>(high), 64) + low,
+                               exponent - limits::digits);
+        break;
+    case long_double_class::infinity:
+        magnitude = limits::infinity();
+        break;
+    case long_double_class::nan:
+        magnitude = limits::quiet_NaN();
+        break;
+    default:
+        istream.setstate(std::ios_base::failbit);  // unknown class
+        return false;
+    }
+    value = (kind & long_double_sign) ? -magnitude : magnitude;
+    return true;
+}
+
+/**
+ * @brief longest LEB128 encoding of a 64-bit value
+ */
+static constexpr std::size_t max_varint_length { 10 };
+
+/**
+ * @brief encodes value as LEB128 at out, returning the count of bytes used
+ */
+inline std::size_t encode_varint(std::uint64_t value, char* out) noexcept
+{
+    std::size_t length {};
+    for (; value >= 0x80; value >>= 7)
+        out[length++] = static_cast<char>((value & 0x7f) | 0x80);
+    out[length++] = static_cast<char>(value);
+    return length;
+}
+
+/**
+ * @brief reads LEB128 value from stream buffer, setting eofbit and failbit if
+ *   the stream ends first, or failbit if the encoding exceeds 64 bits
+ */
+template <typename StreamType>
+bool read_varint(StreamType& istream, std::uint64_t& value)
+{
+    using traits_type = typename StreamType::traits_type;
+
+    if (!istream.good())
+        return false;
+    auto* buffer { istream.rdbuf() };
+    value = 0;
+    for (unsigned shift {}; shift < 64; shift += 7) {
+        const auto c { buffer->sbumpc() };
+        if (traits_type::eq_int_type(c, traits_type::eof())) {
+            istream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+            return false;
+        }
+        const auto byte { static_cast<unsigned char>(traits_type::to_char_type(c)) };
+        // the tenth byte can only contribute the 64th bit
+        if (shift == 63 && byte > 1)
+            break;
+        value |= std::uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    istream.setstate(std::ios_base::failbit);
+    return false;
+}
+
+/**
+ * @brief maps integral values to the unsigned values stored as varints
+ * @notes overloads as follows:
+ *   - unsigned: value as is
+ *   - signed: zigzag encoding, interleaving negative and positive values so
+ *       that values of small magnitude get short encodings
+ */
+template <typename ValueType>
+constexpr auto to_varint(const ValueType value) noexcept -> std::enable_if_t<
+    std::is_unsigned<ValueType>::value,
+    std::uint64_t>
+{
+    return value;
+}
+
+template <typename ValueType>
+constexpr auto to_varint(const ValueType value) noexcept -> std::enable_if_t<
+    std::is_signed<ValueType>::value,
+    std::uint64_t>
+{
+    return value < 0 ? ~(std::uint64_t(value) << 1) : std::uint64_t(value) << 1;
+}
+
+/**
+ * @brief maps varints back to integral values, failing on values out of range
+ *   of the integral type
+ */
+template <typename ValueType>
+auto from_varint(const std::uint64_t varint, ValueType& value
+    ) noexcept -> std::enable_if_t<
+        std::is_unsigned<ValueType>::value,
+        bool>
+{
+    if (varint > std::numeric_limits<ValueType>::max())
+        return false;
+    value = ValueType(varint);
+    return true;
+}
+
+template <typename ValueType>
+auto from_varint(const std::uint64_t varint, ValueType& value
+    ) noexcept -> std::enable_if_t<
+        std::is_signed<ValueType>::value,
+        bool>
+{
+    const auto magnitude { varint >> 1 };
+    if (magnitude > std::uint64_t(std::numeric_limits<ValueType>::max()))
+        return false;
+    value = (varint & 1) ? ValueType(-ValueType(magnitude) - 1) : ValueType(magnitude);
+    return true;
+}
+
+template <typename StreamType>
+void write_varint(StreamType& ostream, const std::uint64_t varint)
+{
+    char bytes[max_varint_length];
+    write_bytes(ostream, bytes, encode_varint(varint, bytes));
+}
+
+/**
+ * @brief writes or reads arithmetic value per integer encoding
+ * @notes overloads as follows:
+ *   - fixed size encoding
+ *   - varint encoding
+ */
+template <integer_encoding Encoding, typename StreamType, typename ValueType>
+auto write_number(StreamType& ostream, const ValueType value
+    ) -> std::enable_if_t<
+        Encoding == integer_encoding::fixed || !is_varint_type<ValueType>::value,
+        void>
+{
+    write_value(ostream, value);
+}
+
+template <integer_encoding Encoding, typename StreamType, typename ValueType>
+auto write_number(StreamType& ostream, const ValueType value
+    ) -> std::enable_if_t<
+        Encoding == integer_encoding::varint && is_varint_type<ValueType>::value,
+        void>
+{
+    write_varint(ostream, to_varint(value));
+}
+
+template <integer_encoding Encoding, typename StreamType, typename ValueType>
+auto read_number(StreamType& istream, ValueType& value
+    ) -> std::enable_if_t<
+        Encoding == integer_encoding::fixed || !is_varint_type<ValueType>::value,
+        bool>
+{
+    return read_value(istream, value);
+}
+
+template <integer_encoding Encoding, typename StreamType, typename ValueType>
+auto read_number(StreamType& istream, ValueType& value
+    ) -> std::enable_if_t<
+        Encoding == integer_encoding::varint && is_varint_type<ValueType>::value,
+        bool>
+{
+    std::uint64_t varint;
+    if (!read_varint(istream, varint))
+        return false;
+    if (!from_varint(varint, value)) {
+        istream.setstate(std::ios_base::failbit);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief size of the blocks that string code units and batched varints are
+ *   encoded or decoded in, also limiting allocations ahead of reading from a
+ *   serialization with a corrupt length
+ */
+static constexpr std::size_t block_size { 4096 };
+
+template <integer_encoding Encoding, typename StreamType, typename CharType>
+void write_string(StreamType& ostream, const CharType* data,
+                  const std::size_t length)
+{
+    write_number<Encoding>(ostream, length_type(length));
+    if (sizeof(CharType) == 1) {
+        write_bytes(ostream, reinterpret_cast<const char*>(data), length);
+        return;
+    }
+    char block[block_size];
+    static constexpr std::size_t units_per_block { block_size / sizeof(CharType) };
+    for (std::size_t i {}; i < length && ostream.good(); i += units_per_block) {
+        const auto count { std::min(units_per_block, length - i) };
+        for (std::size_t j {}; j < count; ++j)
+            encode(data[i + j], block + j * sizeof(CharType));
+        write_bytes(ostream, block, count * sizeof(CharType));
+    }
+}
+
+template <integer_encoding Encoding, typename StreamType, typename CharType,
+          typename TraitsType, typename AllocType>
+void read_string(StreamType& istream,
+                 std::basic_string<CharType, TraitsType, AllocType>& string)
+{
+    length_type length;
+    if (!read_number<Encoding>(istream, length))
+        return;
+    string.clear();
+    char block[block_size];
+    static constexpr std::size_t units_per_block { block_size / sizeof(CharType) };
+    while (length > 0) {
+        const auto count { std::size_t(std::min(length_type(units_per_block), length)) };
+        if (!read_bytes(istream, block, count * sizeof(CharType)))
+            return;
+        const auto size { string.size() };
+        string.resize(size + count);
+        for (std::size_t j {}; j < count; ++j)
+            string[size + j] = decode<CharType>(block + j * sizeof(CharType));
+        length -= count;
+    }
+}
+
+/**
+ * @brief helper to write_container, counts elements of a container for its
+ *   length prefix
+ * @notes overloads as follows:
+ *   - C array
+ *   - classes with member size()
+ *   - default: iterable classes with forward iterators but without member
+ *       size(), eg std::forward_list
+ *   - C++20 forward ranges without member size() or forward iterators of
+ *       const containers, eg std::views::filter
+ *   - std::pair
+ *   - std::tuple
+ */
+template <typename ElementType, std::size_t ArraySize>
+constexpr std::size_t element_count(const ElementType (&)[ArraySize]) noexcept
+{
+    return ArraySize;
+}
+
+template <typename ContainerType>
+auto element_count(const ContainerType& container) noexcept
+    -> decltype(std::size_t(container.size()))
+{
+    return container.size();
+}
+
+template <typename ContainerType, typename... Ignored>
+auto element_count(const ContainerType& container, Ignored...
+    ) -> std::enable_if_t<
+        has_forward_iterator<ContainerType>::value,
+        std::size_t>
+{
+    return std::size_t(std::distance(std::begin(container), std::end(container)));
+}
+
+#ifdef __cpp_lib_ranges
+template <typename RangeType, typename... Ignored>
+    requires (!has_forward_iterator<RangeType>::value &&
+              is_forward_range<RangeType>::value)
+std::size_t element_count(const RangeType& range, Ignored...)
+{
+    if constexpr (std::ranges::forward_range<const RangeType>) {
+        return std::size_t(std::ranges::distance(range));
+    } else {
+        // views are cheap to copy by definition
+        RangeType view { range };
+        return std::size_t(std::ranges::distance(view));
+    }
+}
+
+#endif  // __cpp_lib_ranges
+
+template <typename FirstType, typename SecondType>
+constexpr std::size_t element_count(const std::pair<FirstType, SecondType>&) noexcept
+{
+    return 2;
+}
+
+template <typename... Args>
+constexpr std::size_t element_count(const std::tuple<Args...>&) noexcept
+{
+    return sizeof...(Args);
+}
+
+/**
+ * @brief helper to write_container, copies the elements of a single pass
+ *   container into a std::vector
+ * @notes overloads as follows:
+ *   - default: containers iterable when const
+ *   - C++20 views only iterable when non-const, copied as with
+ *       output::to_stream
+ */
+template <typename ContainerType, typename... Ignored>
+auto buffer_elements(const ContainerType& container, Ignored...)
+    -> std::vector<std::decay_t<decltype(*std::begin(container))>>
+{
+    std::vector<std::decay_t<decltype(*std::begin(container))>> elements;
+    for (auto&& element : container)
+        elements.emplace_back(element);
+    return elements;
+}
+
+#ifdef __cpp_lib_ranges
+template <typename RangeType>
+    requires (!std::ranges::input_range<const RangeType> &&
+              traits::is_printable_as_range<RangeType>::value)
+std::vector<std::ranges::range_value_t<RangeType>> buffer_elements(
+    const RangeType& range)
+{
+    std::vector<std::ranges::range_value_t<RangeType>> elements;
+    RangeType view { range };
+    for (auto&& element : view)
+        elements.emplace_back(element);
+    return elements;
+}
+
+#endif  // __cpp_lib_ranges
+/**
+ * @brief writes container (top level or nested) to stream
+ * @notes overloads as follows:
+ *   - default: output::to_stream with output_formatter
+ *   - std::vector of varint types with integer_encoding::varint: varints
+ *       encoded in blocks
+ *   - contiguous containers of bulk elements: raw bytes of all elements
+ *       written at once
+ *   - single pass containers: elements buffered in a std::vector, as they
+ *       can't be counted ahead of writing them without consuming them
+ */
+template <integer_encoding Encoding, typename ContainerType, typename StreamType>
+auto write_container(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+        !is_single_pass<ContainerType>::value &&
+        !is_batched_varint_container<ContainerType, Encoding>::value &&
+        !is_bulk_container<ContainerType, Encoding>::value,
+        void>
+{
+    using formatter_type = output_formatter<ContainerType, StreamType, Encoding>;
+    output::to_stream(ostream, container,
+                      formatter_type { element_count(container) });
+}
+
+template <integer_encoding Encoding, typename ContainerType, typename StreamType>
+auto write_container(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+        is_batched_varint_container<ContainerType, Encoding>::value,
+        void>
+{
+    write_varint(ostream, container.size());
+    char block[block_size];
+    std::size_t length {};
+    for (const auto element : container) {
+        if (length > block_size - max_varint_length) {
+            write_bytes(ostream, block, length);
+            length = 0;
+        }
+        length += encode_varint(to_varint(element), block + length);
+    }
+    write_bytes(ostream, block, length);
+}
+
+template <integer_encoding Encoding, typename ContainerType, typename StreamType>
+auto write_container(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+        is_bulk_container<ContainerType, Encoding>::value,
+        void>
+{
+    const auto size { traits::contiguous_size(container) };
+    write_number<Encoding>(ostream, length_type(size));
+    write_bytes(ostream, reinterpret_cast<const char*>(traits::contiguous_data(container)),
+                size * sizeof(*traits::contiguous_data(container)));
+}
+
+template <integer_encoding Encoding, typename ContainerType, typename StreamType>
+auto write_container(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+        is_single_pass<ContainerType>::value,
+        void>
+{
+    write_container<Encoding>(ostream, buffer_elements(container));
+}
+
+/**
+ * @brief reads container (top level or nested) from stream
+ * @notes overloads as follows:
+ *   - default: input::from_stream with input_formatter
+ *   - std::vector of varint types with integer_encoding::varint: varints
+ *       decoded in a single loop, without the per element suffix checks of
+ *       from_stream
+ *   - std::vector of bulk elements: raw bytes read into the vector, sized
+ *       ahead of time when the stream buffer has that many bytes available
+ *   - std::array and C array of bulk elements: raw bytes read at once
+ */
+template <integer_encoding Encoding, typename ContainerType, typename StreamType>
+auto read_container(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+        !is_batched_varint_container<ContainerType, Encoding>::value &&
+        !is_bulk_container<ContainerType, Encoding>::value,
+        void>
+{
+    using formatter_type = input_formatter<ContainerType, StreamType, Encoding>;
+    input::from_stream(istream, container, formatter_type{});
+}
+
+template <integer_encoding Encoding, typename ContainerType, typename StreamType>
+auto read_container(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+        is_batched_varint_container<ContainerType, Encoding>::value,
+        void>
+{
+    length_type length;
+    if (!read_number<Encoding>(istream, length))
+        return;
+    ContainerType new_container;
+    new_container.reserve(std::size_t(std::min(length, length_type(block_size))));
+    typename ContainerType::value_type element;
+    for (std::uint64_t varint; length > 0; --length) {
+        if (!read_varint(istream, varint))
+            return;
+        if (!from_varint(varint, element)) {
+            istream.setstate(std::ios_base::failbit);
+            return;
+        }
+        new_container.push_back(element);
+    }
+    container = std::move(new_container);
+}
+
+/**
+ * @brief helper to read_container, reads raw bytes of a fixed size array of
+ *   bulk elements, failing if the serialized length differs
+ */
+template <integer_encoding Encoding, typename StreamType, typename ElementType>
+void read_bulk_array(StreamType& istream, ElementType* data, const std::size_t size)
+{
+    length_type length;
+    if (!read_number<Encoding>(istream, length))
+        return;
+    if (length != size) {
+        istream.setstate(std::ios_base::failbit);
+        return;
+    }
+    // read into temporary to leave array unmodified on failure
+    std::vector<ElementType> temp(size);
+    if (read_bytes(istream, reinterpret_cast<char*>(temp.data()),
+                   size * sizeof(ElementType)))
+        std::copy(temp.begin(), temp.end(), data);
+}
+
+template <integer_encoding Encoding, typename ElementType, typename AllocType,
+          typename StreamType>
+auto read_container(StreamType& istream,
+                    std::vector<ElementType, AllocType>& container
+    ) -> std::enable_if_t<
+        is_bulk_element<ElementType, Encoding>::value,
+        void>
+{
+    length_type length;
+    if (!read_number<Encoding>(istream, length))
+        return;
+    // a length not backed by available bytes may be corrupt, so rather than
+    //   allocating for it all at once, the vector is grown in doubling chunks
+    //   as bytes are read
+    const auto available { istream.rdbuf()->in_avail() };
+    length_type chunk { block_size / sizeof(ElementType) };
+    if (available > 0 && length <= length_type(available) / sizeof(ElementType))
+        chunk = length;
+    std::vector<ElementType, AllocType> new_container;
+    for (length_type size {}; size < length; chunk *= 2) {
+        const auto count { std::size_t(std::min(chunk, length - size)) };
+        new_container.resize(std::size_t(size) + count);
+        if (!read_bytes(istream, reinterpret_cast<char*>(
+                            new_container.data() + size), count * sizeof(ElementType)))
+            return;
+        size += count;
+    }
+    container = std::move(new_container);
+}
+
+template <integer_encoding Encoding, typename ElementType, std::size_t ArraySize,
+          typename StreamType>
+auto read_container(StreamType& istream,
+                    std::array<ElementType, ArraySize>& container
+    ) -> std::enable_if_t<
+        is_bulk_element<ElementType, Encoding>::value,
+        void>
+{
+    read_bulk_array<Encoding>(istream, container.data(), ArraySize);
+}
+
+template <integer_encoding Encoding, typename ElementType, std::size_t ArraySize,
+          typename StreamType>
+auto read_container(StreamType& istream, ElementType (&container)[ArraySize]
+    ) -> std::enable_if_t<
+        is_bulk_element<ElementType, Encoding>::value,
+        void>
+{
+    read_bulk_array<Encoding>(istream, container, ArraySize);
+}
+
+}  // namespace detail
+
+/**
+ * @brief iomanip to set encoding/decoding of integers in binary format to
+ *   fixed size
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& fixedint(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_manip_i()) =
+        static_cast<int>(integer_encoding::fixed);
+    return stream;
+}
+
+/**
+ * @brief iomanip to set encoding/decoding of integers in binary format to
+ *   varints
+ */
+template<typename CharType, typename TraitsType>
+std::basic_ios<CharType, TraitsType>& varint(
+    std::basic_ios<CharType, TraitsType>& stream)
+{
+    stream.iword(detail::get_manip_i()) =
+        static_cast<int>(integer_encoding::varint);
+    return stream;
+}
+
+/**
+ * @brief formatter for the printing of a container in binary format, to be
+ *   used with output::to_stream
+ * @notes each formatter holds the element count of the container it prints,
+ *   nested containers are printed with formatters of their own
+ */
+template <typename ContainerType, typename StreamType, integer_encoding Encoding>
+struct output_formatter
+{
+    explicit output_formatter(const std::size_t element_count = 0) noexcept :
+        count(element_count)
+    {}
+
+    std::size_t count;
+
+    /**
+     * @brief writes element count of containers other than pairs and tuples
+     */
+    void print_prefix(StreamType& ostream) const
+    {
+        if (!detail::is_fixed_arity<ContainerType>::value)
+            detail::write_number<Encoding>(ostream, detail::length_type(count));
+    }
+
+    /**
+     * @brief writes element to stream
+     * @notes overloads as follows:
+     *   - arithmetic types other than bool and long double, including char types
+     *   - bool
+     *   - long double
+     *   - std::basic_string
+     *   - std::basic_string_view
+     *   - C array of char type
+     *   - nested containers
+     */
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) -> std::enable_if_t<
+            detail::is_encodable_arithmetic<ElementType>::value,
+            void>
+    {
+        detail::write_number<Encoding>(ostream, element);
+    }
+
+    static void print_element(StreamType& ostream, const bool element)
+    {
+        detail::write_value(ostream, std::uint8_t(element ? 1 : 0));
+    }
+
+    static void print_element(StreamType& ostream, const long double element)
+    {
+        detail::write_long_double(ostream, element);
+    }
+
+    template <typename CharType, typename TraitsType, typename AllocType>
+    static void print_element(
+        StreamType& ostream,
+        const std::basic_string<CharType, TraitsType, AllocType>& element)
+    {
+        detail::write_string<Encoding>(ostream, element.data(), element.size());
+    }
+
+#if (__cplusplus >= 201703L)
+    template <typename CharType, typename TraitsType>
+    static void print_element(
+        StreamType& ostream,
+        const std::basic_string_view<CharType, TraitsType>& element)
+    {
+        detail::write_string<Encoding>(ostream, element.data(), element.size());
+    }
+
+#endif
+    template <typename CharType, std::size_t ArraySize>
+    static auto print_element(
+        StreamType& ostream, const CharType (&element)[ArraySize]
+        ) -> std::enable_if_t<
+            traits::is_char_type<CharType>::value,
+            void>
+    {
+        // C char arrays are printed as strings up to their first null, as
+        //   with the default formatter
+        const auto end { std::find(element, element + ArraySize, CharType('\0')) };
+        detail::write_string<Encoding>(ostream, element, std::size_t(end - element));
+    }
+
+    template <typename ElementType>
+    static auto print_element(StreamType& ostream, const ElementType& element
+        ) -> std::enable_if_t<
+            traits::is_printable_as_container<ElementType>::value,
+            void>
+    {
+        detail::write_container<Encoding>(ostream, element);
+    }
+
+    /**
+     * @brief no separators in binary format
+     */
+    static void print_separator(StreamType& /*ostream*/) noexcept
+    {}
+
+    /**
+     * @brief no suffixes in binary format
+     */
+    static void print_suffix(StreamType& /*ostream*/) noexcept
+    {}
+};
+
+/**
+ * @brief formatter for the parsing of a container in binary format, to be used
+ *   with input::from_stream
+ * @notes as from_stream detects the end of a container by a successful
+ *   parse_suffix, each formatter tracks the count of elements remaining in
+ *   the container it parses, with parse_suffix failing (without consuming any
+ *   input) while elements remain
+ */
+template <typename ContainerType, typename StreamType, integer_encoding Encoding>
+struct input_formatter
+{
+    mutable detail::length_type remaining {};
+
+    /**
+     * @brief reads element count of containers other than pairs and tuples
+     */
+    void parse_prefix(StreamType& istream) const
+    {
+        if (!detail::is_fixed_arity<ContainerType>::value)
+            detail::read_number<Encoding>(istream, remaining);
+    }
+
+    /**
+     * @brief reads element from stream
+     * @notes overloads as follows:
+     *   - arithmetic types other than bool and long double, including char types
+     *   - bool
+     *   - long double
+     *   - std::basic_string
+     *   - C array of char type
+     *   - nested containers
+     */
+    template <typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            detail::is_encodable_arithmetic<ElementType>::value,
+            void>
+    {
+        if (claim_element(istream))
+            detail::read_number<Encoding>(istream, element);
+    }
+
+    void parse_element(StreamType& istream, bool& element) const
+    {
+        std::uint8_t byte;
+        if (!claim_element(istream) || !detail::read_value(istream, byte))
+            return;
+        if (byte > 1)
+            istream.setstate(std::ios_base::failbit);
+        else
+            element = (byte == 1);
+    }
+
+    void parse_element(StreamType& istream, long double& element) const
+    {
+        if (claim_element(istream))
+            detail::read_long_double(istream, element);
+    }
+
+    template <typename CharType, typename TraitsType, typename AllocType>
+    void parse_element(
+        StreamType& istream,
+        std::basic_string<CharType, TraitsType, AllocType>& element) const
+    {
+        if (claim_element(istream))
+            detail::read_string<Encoding>(istream, element);
+    }
+
+    template <typename CharType, std::size_t ArraySize>
+    auto parse_element(
+        StreamType& istream, CharType (&element)[ArraySize]
+        ) const -> std::enable_if_t<
+            traits::is_char_type<CharType>::value,
+            void>
+    {
+        if (!claim_element(istream))
+            return;
+        std::basic_string<CharType> s;
+        detail::read_string<Encoding>(istream, s);
+        if (!istream.good())
+            return;
+        if (s.size() < ArraySize)
+        {
+            auto it {std::copy(s.begin(), s.end(), std::begin(element))};
+            std::fill(it, std::end(element), CharType('\0'));
+        }
+        else
+        {
+            istream.setstate(std::ios_base::failbit);
+        }
+    }
+
+    template <typename ElementType>
+    auto parse_element(StreamType& istream, ElementType& element
+        ) const -> std::enable_if_t<
+            traits::is_parseable_as_container<ElementType>::value,
+            void>
+    {
+        if (claim_element(istream))
+            detail::read_container<Encoding>(istream, element);
+    }
+
+    /**
+     * @brief no separators in binary format
+     */
+    static void parse_separator(StreamType& /*istream*/) noexcept
+    {}
+
+    /**
+     * @brief fails while elements remain in container
+     */
+    void parse_suffix(StreamType& istream) const noexcept
+    {
+        if (remaining != 0)
+            istream.setstate(std::ios_base::failbit);
+    }
+
+private:
+    /**
+     * @brief counts an element against the element count read by
+     *   parse_prefix, failing if the count is exceeded
+     */
+    bool claim_element(StreamType& istream) const noexcept
+    {
+        if (detail::is_fixed_arity<ContainerType>::value)
+            return true;
+        if (remaining == 0) {
+            istream.setstate(std::ios_base::failbit);
+            return false;
+        }
+        --remaining;
+        return true;
+    }
+};
+
+/**
+ * @brief writes compatible container to stream in binary format, with the
+ *   integer encoding set on the stream by fixedint/varint
+ */
+template <typename ContainerType, typename StreamType>
+auto to_stream(StreamType& ostream, const ContainerType& container
+    ) -> std::enable_if_t<
+    traits::is_printable_as_container<ContainerType>::value,
+    StreamType&>
+{
+    if (static_cast<integer_encoding>(ostream.iword(detail::get_manip_i())) ==
+        integer_encoding::varint)
+        detail::write_container<integer_encoding::varint>(ostream, container);
+    else
+        detail::write_container<integer_encoding::fixed>(ostream, container);
+    return ostream;
+}
+
+/**
+ * @brief reads compatible container from stream in binary format, with the
+ *   integer encoding set on the stream by fixedint/varint
+ * @notes as with operator>>, container is only modified if extraction
+ *   succeeds
+ */
+template <typename ContainerType, typename StreamType>
+auto from_stream(StreamType& istream, ContainerType& container
+    ) -> std::enable_if_t<
+    traits::is_parseable_as_container<ContainerType>::value,
+    StreamType&>
+{
+    if (static_cast<integer_encoding>(istream.iword(detail::get_manip_i())) ==
+        integer_encoding::varint)
+        detail::read_container<integer_encoding::varint>(istream, container);
+    else
+        detail::read_container<integer_encoding::fixed>(istream, container);
+    return istream;
+}
+
+}  // namespace binary
+
+/**
+ * @brief contains stream buffers and cursors over memory regions
+ * @notes loading and saving of container serializations from and to files
+ *   (load_file, save_file) are opt-in, by including container_stream_io_file.hh,
+ *   which brings in the platform headers they need
+ */
+namespace memory {
+
+/**
+ * @brief read-only stream buffer over a contiguous region of memory, letting
+ *   streams parse directly out of the region without copying it
+ * @notes
+ *   - the region must outlive the buffer
+ *   - supports seeking (eg to rewind after input::validate), but not putback
+ *       of chars other than those last extracted
+ */
+template <typename CharType, typename TraitsType>
+class basic_input_buffer : public std::basic_streambuf<CharType, TraitsType>
+{
+public:
+    using char_type = CharType;
+    using traits_type = TraitsType;
+    using int_type = typename traits_type::int_type;
+    using pos_type = typename traits_type::pos_type;
+    using off_type = typename traits_type::off_type;
+
+    basic_input_buffer(const char_type* data, const std::size_t size)
+    {
+        // get area is never written to, as putback is limited to chars
+        //   matching those already in the region
+        auto* begin { const_cast<char_type*>(data) };
+        this->setg(begin, begin, begin + size);
+    }
+
+    basic_input_buffer(const basic_input_buffer&) = delete;
+    basic_input_buffer& operator=(const basic_input_buffer&) = delete;
+
+    /**
+     * @brief gets position of the next char to be read, and the end of the
+     *   region, for parsers working on the region directly
+     */
+    const char_type* next() const noexcept
+    {
+        return this->gptr();
+    }
+
+    const char_type* end() const noexcept
+    {
+        return this->egptr();
+    }
+
+    /**
+     * @brief sets position of the next char to be read, which must be within
+     *   the region
+     */
+    void set_next(const char_type* next) noexcept
+    {
+        this->setg(this->eback(), const_cast<char_type*>(next), this->egptr());
+    }
 
-        formatter.parse_element(istream, temp_elem);
-        if (!istream.good())
-            return istream;
-        emplace_element(new_container, temp_elem);
+protected:
+    std::streamsize showmanyc() override
+    {
+        // only called once get area is exhausted, with no more input to come
+        return -1;
     }
 
-    // C arrays not allowed as STL container members due to non-move-
-    //   constructiblity, so no need for c_array_compatible_move_assignment
-    if (istream.good())
-        container = std::move(new_container);
-    return istream;
-}
+    pos_type seekoff(const off_type off, const std::ios_base::seekdir dir,
+                     const std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+        off_type base {};
+        if (dir == std::ios_base::cur)
+            base = this->gptr() - this->eback();
+        else if (dir == std::ios_base::end)
+            base = this->egptr() - this->eback();
+        return seekpos(pos_type(base + off), which);
+    }
 
-}  // namespace input
+    pos_type seekpos(const pos_type pos,
+                     const std::ios_base::openmode which) override
+    {
+        const auto off { off_type(pos) };
+        if (!(which & std::ios_base::in) || off < 0 ||
+            off > this->egptr() - this->eback())
+            return pos_type(off_type(-1));
+        this->setg(this->eback(), this->eback() + off, this->egptr());
+        return pos;
+    }
+};
 
-/**
- * @brief contains functions to govern output streaming/insertion of compatible
- *   containers
- */
-namespace output {
+using input_buffer = basic_input_buffer<char>;
 
 /**
- * @brief default formatter for the printing of decorators and elements in a
- *   container serialization
+ * @brief on-demand cursor over a container serialization in memory, which
+ *   steps into containers and decodes only the elements requested, skipping
+ *   the others with structure::scanner
+ * @notes
+ *   - elements are visited in order: the root element, then after entering a
+ *       container, each of its elements as next() returns true
+ *   - expects the default decorators of the container types entered, and the
+ *       default string delimiter and escape
+ *   - next(), leave() and get() return false on malformed serializations,
+ *       setting failbit of stream(), which also holds the formatting state
+ *       used to decode elements (eg literalrepr/quotedrepr)
+ *   - the region must outlive the cursor
  */
-template <typename ContainerType, typename StreamType>
-struct default_formatter
+template <typename CharType, typename TraitsType = std::char_traits<CharType>>
+class basic_cursor
 {
-    static constexpr auto decorators {
-        decorator::delimiters<ContainerType, typename StreamType::char_type>::values };
+public:
+    using char_type = CharType;
+    using stream_type = std::basic_istream<CharType, TraitsType>;
 
-    using repr_type = strings::detail::repr_type;
+    basic_cursor(const char_type* data, const std::size_t size) :
+        buffer_(data, size), stream_(&buffer_)
+    {}
+
+    basic_cursor(const basic_cursor&) = delete;
+    basic_cursor& operator=(const basic_cursor&) = delete;
+
+    stream_type& stream() noexcept
+    {
+        return stream_;
+    }
+
+    explicit operator bool() const
+    {
+        return !stream_.fail();
+    }
 
     /**
-     * @brief inserts prefix decorator in stream
+     * @brief gets position of the next char to be read
      */
-    static void print_prefix(StreamType& ostream) noexcept
+    const char_type* position() const noexcept
     {
-        ostream << decorators.prefix;
+        return buffer_.next();
     }
 
     /**
-     * @brief inserts element in stream
-     * @notes overloads as follows:
-     *   - default
-     *   - char or string types (C or STL)
+     * @brief gets count of containers entered and not yet left
      */
-    template <typename ElementType>
-    static auto print_element(StreamType& ostream, const ElementType& element
-        ) noexcept -> std::enable_if_t<
-            !traits::is_char_type<ElementType>::value &&
-            !traits::is_string_type<ElementType>::value,
-            void>
+    std::size_t depth() const noexcept
     {
-        ostream << element;
+        return frames_.size();
     }
 
-    template<typename ElementType>
-    static auto print_element(StreamType& ostream, const ElementType& element
-        ) noexcept -> std::enable_if_t<
-            traits::is_char_type<ElementType>::value ||
-            traits::is_string_type<ElementType>::value,
-            void>
+    /**
+     * @brief steps into current element, extracting its prefix
+     */
+    template <typename ContainerType>
+    bool enter()
     {
-        if (static_cast<repr_type>(
-                ostream.iword(strings::detail::get_manip_i())) == repr_type::quoted)
-            ostream << strings::quoted(element);
+        static constexpr auto decorators {
+            decorator::delimiters<ContainerType, char_type>::values };
+        if (!claim())
+            return false;
+        if (!match(decorators.prefix))
+            return fail();
+        frames_.push_back(frame { decorators.separator, decorators.suffix, true });
+        return true;
+    }
+
+    /**
+     * @brief advances to next element of the current container, skipping the
+     *   current element if it was not decoded or entered
+     * @return false once the suffix is extracted, which leaves the container
+     */
+    bool next()
+    {
+        if (stream_.fail() || frames_.empty())
+            return false;
+        if (pending_)
+            skip();
+        if (stream_.fail())
+            return false;
+        auto& f { frames_.back() };
+        if (match(f.suffix)) {
+            frames_.pop_back();
+            return false;
+        }
+        if (f.first)
+            f.first = false;
+        else if (!match(f.separator))
+            return fail();
+        pending_ = true;
+        return true;
+    }
+
+    /**
+     * @brief skips remaining elements and suffix of the current container
+     */
+    bool leave()
+    {
+        const auto depth { frames_.size() };
+        if (depth == 0)
+            return fail();
+        while (next())
+            ;
+        return !stream_.fail() && frames_.size() < depth;
+    }
+
+    /**
+     * @brief skips current element without decoding it, see
+     *   input::skip_element
+     */
+    void skip()
+    {
+        if (!claim())
+            return;
+        if (frames_.empty())
+            input::skip_element(stream_);
         else
-            ostream << strings::literal(element);
+            input::skip_element(stream_, frames_.back().separator);
     }
 
     /**
-     * @brief inserts separator and whitespace decorators in stream
+     * @brief decodes current element as by operator>> of its container
      */
-    static void print_separator(StreamType& ostream) noexcept
+    template <typename ElementType>
+    bool get(ElementType& element)
     {
-        ostream << decorators.separator << decorators.whitespace;
+        if (!claim())
+            return false;
+        const input::default_formatter<ElementType, stream_type> formatter {};
+        input::context<stream_type> call_context { stream_ };
+        input::invoke_parse_element(formatter, stream_, element, call_context, 0);
+        return !stream_.fail();
+    }
+
+private:
+    struct frame
+    {
+        const char_type* separator;
+        const char_type* suffix;
+        bool first;
+    };
+
+    bool fail()
+    {
+        stream_.setstate(std::ios_base::failbit);
+        return false;
     }
 
     /**
-     * @brief inserts suffix decorator in stream
+     * @brief marks current element as visited, failing if there is none
      */
-    static void print_suffix(StreamType& ostream) noexcept
+    bool claim()
+    {
+        if (stream_.fail())
+            return false;
+        if (!pending_)
+            return fail();
+        pending_ = false;
+        return true;
+    }
+
+    bool match(const char_type* token)
     {
-        ostream << decorators.suffix;
+        stream_ >> std::ws;
+        const auto* next { buffer_.next() };
+        const auto length { TraitsType::length(token) };
+        if (std::size_t(buffer_.end() - next) < length ||
+            TraitsType::compare(next, token, length) != 0)
+            return false;
+        buffer_.set_next(next + length);
+        return true;
     }
+
+    basic_input_buffer<char_type, TraitsType> buffer_;
+    stream_type stream_;
+    std::vector<frame> frames_;
+    bool pending_ { true };  // current element not yet visited
 };
 
+using cursor = basic_cursor<char>;
+
+}  // namespace memory
+
 /**
- * @brief helper to to_stream(tuple), recursive struct meant to unpack and
- *   parse std::tuple elements
+ * @brief contains multithreaded versions of stream insertion and extraction,
+ *   for large top-level containers
+ */
+namespace parallel {
+
+/**
+ * @brief minimum count of elements formatted by each thread, below which
+ *   formatting is left to a single thread
+ */
+static constexpr std::size_t min_chunk_size { std::size_t(1) << 14 };
+
+namespace detail {
+
+/**
+ * @brief tests for containers with random access iterators, which can be
+ *   split into ranges of elements in constant time, eg std::vector,
+ *   std::deque, std::array, C arrays
+ */
+template <typename Type, typename = void>
+struct is_random_access_container : public std::false_type
+{};
+
+template <typename Type>
+struct is_random_access_container<
+    Type, std::void_t<decltype(std::begin(std::declval<const Type&>()))>>
+    : public std::is_base_of<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<
+        decltype(std::begin(std::declval<const Type&>()))>::iterator_category>
+{};
+
+/**
+ * @brief prints elements [first, last) of container, with separators between
+ *   them but without prefix or suffix
  * @notes overloads as follows:
  *   - default
- *   - last element in tuple
+ *   - contiguous containers of numeric types: print_contiguous_numeric_elements,
+ *       if stream formatting state allows
  */
-template <typename TupleType, std::size_t Index, std::size_t Last>
-struct tuple_handler
+template <typename FormatterType, typename ContainerType, typename StreamType>
+auto print_chunk(StreamType& ostream, const ContainerType& container,
+                 const std::size_t first, const std::size_t last
+    ) -> std::enable_if_t<
+        !traits::is_contiguous_numeric_container<ContainerType>::value,
+        void>
 {
-    template <typename StreamType, typename FormatterType>
-    static void print(
-        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter)
-    {
-        formatter.print_element(ostream, std::get<Index>(tuple));
-        formatter.print_separator(ostream);
-        tuple_handler<TupleType, Index + 1, Last>::print(ostream, tuple, formatter);
+    const FormatterType formatter {};
+    output::context<StreamType> call_context { ostream };
+    auto it { std::begin(container) };
+    std::advance(it, first);
+    for (std::size_t i { first }; i < last; ++i, ++it) {
+        if (i != first)
+            formatter.print_separator(ostream);
+        output::invoke_print_element(formatter, ostream, *it, call_context, 0);
     }
-};
+}
 
-template <typename TupleType, std::size_t Index>
-struct tuple_handler<TupleType, Index, Index>
+template <typename FormatterType, typename ContainerType, typename StreamType>
+auto print_chunk(StreamType& ostream, const ContainerType& container,
+                 const std::size_t first, const std::size_t last
+    ) -> std::enable_if_t<
+        traits::is_contiguous_numeric_container<ContainerType>::value,
+        void>
 {
-    template <typename StreamType, typename FormatterType>
-    static void print(
-        StreamType& ostream, const TupleType& tuple, const FormatterType& formatter) noexcept
-    {
-        formatter.print_element(ostream, std::get<Index>(tuple));
+    const auto data { traits::contiguous_data(container) };
+    if (output::has_default_number_format(ostream)) {
+        output::print_contiguous_numeric_elements<FormatterType>(
+            ostream, data + first, last - first);
+        return;
     }
-};
+    const FormatterType formatter {};
+    output::context<StreamType> call_context { ostream };
+    for (std::size_t i { first }; i < last; ++i) {
+        if (i != first)
+            formatter.print_separator(ostream);
+        output::invoke_print_element(formatter, ostream, data[i], call_context, 0);
+    }
+}
+
+}  // namespace detail
 
 /**
- * @brief stream insertion of compatible container type
- * @notes overloads as follows:
- *   - std::tuple<T...>
- *   - std::tuple<>
- *   - std::pair
- *   - default: intended for "iterable" STL containers (see
- *       traits::is_printable_as_container)
+ * @brief stream insertion of compatible container with random access
+ *   iterators, formatting contiguous ranges of its elements on separate
+ *   threads
+ * @notes
+ *   - output is the same as with operator<<, each thread formats into its own
+ *       string stream, sharing the formatting state (flags, locale,
+ *       literalrepr/quotedrepr) of ostream, and the strings are inserted in
+ *       order once formatted
+ *   - uses up to thread_count threads, each formatting at least
+ *       min_chunk_size elements, smaller containers are formatted on the
+ *       calling thread
+ *   - the whole serialization is held in memory before insertion completes
  */
-template <typename StreamType, typename FormatterType, typename... TupleArgs>
-static StreamType& to_stream(
-    StreamType& ostream, const std::tuple<TupleArgs...>& tuple,
-    const FormatterType& formatter)
+template <typename ContainerType, typename StreamType>
+auto to_stream(StreamType& ostream, const ContainerType& container,
+               const std::size_t thread_count = std::thread::hardware_concurrency()
+    ) -> std::enable_if_t<
+    traits::is_printable_as_container<ContainerType>::value &&
+    detail::is_random_access_container<ContainerType>::value,
+    StreamType&>
 {
-    using TupleType = std::decay_t<decltype(tuple)>;
+    using stream_char_type = typename StreamType::char_type;
+    using traits_type = typename StreamType::traits_type;
+    using chunk_stream_type = std::basic_ostream<stream_char_type, traits_type>;
+    using formatter_type = output::default_formatter<ContainerType, chunk_stream_type>;
+
+    const auto size {
+        std::size_t(std::distance(std::begin(container), std::end(container))) };
+    const auto chunk_count { std::min(thread_count, size / min_chunk_size) };
+    if (chunk_count < 2) {
+        using single_formatter_type = output::default_formatter<ContainerType, StreamType>;
+        return output::to_stream(ostream, container, single_formatter_type{});
+    }
+
+    // stringstreams rather than ostringstreams, to be read back out of
+    std::vector<std::basic_stringstream<stream_char_type, traits_type>> chunks(chunk_count);
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(chunk_count);
+    for (std::size_t i {}; i < chunk_count; ++i) {
+        // formatting state copied here, as ostream is written to concurrently
+        chunks[i].copyfmt(ostream);
+        const std::size_t first { size * i / chunk_count };
+        const std::size_t last { size * (i + 1) / chunk_count };
+        chunk_stream_type* chunk { &chunks[i] };
+        tasks.push_back(std::async(std::launch::async, [&container, chunk, first, last]() {
+            detail::print_chunk<formatter_type>(*chunk, container, first, last);
+        }));
+    }
 
+    const formatter_type formatter {};
     formatter.print_prefix(ostream);
-    container_stream_io::output::tuple_handler<
-        TupleType, 0, sizeof...(TupleArgs) - 1>::print(ostream, tuple, formatter);
+    for (std::size_t i {}; i < chunk_count; ++i) {
+        tasks[i].get();
+        if (i != 0)
+            formatter.print_separator(ostream);
+        ostream << chunks[i].rdbuf();
+    }
     formatter.print_suffix(ostream);
 
     return ostream;
 }
 
-template <typename StreamType, typename FormatterType, typename... TupleArgs>
-static StreamType& to_stream(
-    StreamType& ostream, const std::tuple<>& /*tuple*/,
-    const FormatterType& formatter)
+/**
+ * @brief minimum count of chars parsed by each thread, below which parsing is
+ *   left to a single thread
+ */
+static constexpr std::size_t min_chunk_length { std::size_t(1) << 16 };
+
+namespace detail {
+
+/**
+ * @brief stage one of parallel parsing, scans the elements of a container
+ *   serialization, starting after its prefix, for its suffix and for
+ *   separators at which it can be split into chunks of elements
+ * @return position of the suffix of the container, or nullptr if not found,
+ *   boundaries receiving the positions of up to chunk_count - 1 separators,
+ *   each at least chunk_length chars past the previous one
+ * @notes only tracks nesting depth by the tokens of structure::scanner,
+ *   without decoding anything, malformed elements are left to be detected by
+ *   stage two
+ */
+template <typename CharType>
+const CharType* scan_elements(const CharType* first, const CharType* last,
+                              const CharType* separator,
+                              const std::size_t chunk_length,
+                              const std::size_t chunk_count,
+                              std::vector<const CharType*>& boundaries)
 {
-    formatter.print_prefix(ostream);
-    formatter.print_suffix(ostream);
-    return ostream;
+    structure::scanner<CharType> scanner { first, last, separator };
+    const CharType* next_boundary { first + chunk_length };
+    std::size_t depth {};
+    structure::token_type type;
+    const CharType* p;
+    while (scanner.next(type, p)) {
+        if (type == structure::token_type::prefix) {
+            ++depth;
+        } else if (type == structure::token_type::suffix) {
+            if (depth == 0)
+                return p;
+            --depth;
+        } else if (depth == 0 && p >= next_boundary &&
+                   boundaries.size() + 1 < chunk_count) {
+            boundaries.push_back(p);
+            next_boundary = p + chunk_length;
+        }
+    }
+    return nullptr;
 }
 
-template <typename FirstType, typename SecondType, typename StreamType, typename FormatterType>
-static StreamType& to_stream(
-    StreamType& ostream, const std::pair<FirstType, SecondType>& container,
-    const FormatterType& formatter)
+/**
+ * @brief splits the elements of a container serialization into up to
+ *   chunk_count chunks of similar length, see scan_elements
+ * @notes chunks are at least min_chunk_length chars long, so fewer are made
+ *   from shorter serializations
+ */
+template <typename CharType>
+const CharType* split_elements(const CharType* first, const CharType* last,
+                               const CharType* separator,
+                               const std::size_t chunk_count,
+                               std::vector<const CharType*>& boundaries)
 {
-    formatter.print_prefix(ostream);
-    formatter.print_element(ostream, container.first);
-    formatter.print_separator(ostream);
-    formatter.print_element(ostream, container.second);
-    formatter.print_suffix(ostream);
+    const auto chunk_length {
+        std::max(min_chunk_length, std::size_t(last - first) / chunk_count) };
+    return scan_elements(first, last, separator, chunk_length, chunk_count,
+                         boundaries);
+}
 
-    return ostream;
+/**
+ * @brief helper to parse_chunk, parses chunks of indexable containers (see
+ *   structure::from_stream) by their structural tokens where possible
+ * @return true if all of [first, last) was parsed into elements
+ */
+template <typename ContainerType, typename CharType, typename TraitsType>
+auto parse_indexed_chunk(const CharType* first, const CharType* last,
+                         const std::basic_ios<CharType, TraitsType>& format,
+                         std::vector<typename ContainerType::value_type>& elements)
+    -> std::enable_if_t<structure::detail::is_indexable<ContainerType>::value, bool>
+{
+    using stream_type = std::basic_istream<CharType, TraitsType>;
+    using formatter_type = input::default_formatter<ContainerType, stream_type>;
+
+    if (!structure::detail::has_default_number_format(format))
+        return false;
+    structure::detail::indexed_parser<CharType> parser {
+        first, last, formatter_type::decorators.separator };
+    if (parser.template parse_to_end<ContainerType>(elements))
+        return true;
+    elements.clear();
+    return false;
 }
 
-template <typename ContainerType, typename StreamType, typename FormatterType>
-static StreamType& to_stream(
-    StreamType& ostream, const ContainerType& container,
-    const FormatterType& formatter)
+template <typename ContainerType, typename CharType, typename TraitsType>
+auto parse_indexed_chunk(const CharType* /*first*/, const CharType* /*last*/,
+                         const std::basic_ios<CharType, TraitsType>& /*format*/,
+                         std::vector<typename ContainerType::value_type>& /*elements*/)
+    -> std::enable_if_t<!structure::detail::is_indexable<ContainerType>::value, bool>
 {
-    formatter.print_prefix(ostream);
+    return false;
+}
 
-    if (container_stream_io::traits::is_empty(container)) {
-        formatter.print_suffix(ostream);
+/**
+ * @brief stage two of parallel parsing, parses the elements in
+ *   [first, last), separated by separators, as from_stream would between the
+ *   prefix and suffix of ContainerType
+ * @return true if all of [first, last) was parsed into elements
+ */
+template <typename ContainerType, typename CharType, typename TraitsType>
+bool parse_chunk(const CharType* first, const CharType* last,
+                 const std::basic_ios<CharType, TraitsType>& format,
+                 std::vector<typename ContainerType::value_type>& elements)
+{
+    using stream_type = std::basic_istream<CharType, TraitsType>;
+    using formatter_type = input::default_formatter<ContainerType, stream_type>;
+
+    if (parse_indexed_chunk<ContainerType>(first, last, format, elements))
+        return true;
+
+    memory::basic_input_buffer<CharType, TraitsType> buffer {
+        first, std::size_t(last - first) };
+    stream_type istream { &buffer };
+    istream.copyfmt(format);
+    istream.exceptions(std::ios_base::goodbit);
+
+    const formatter_type formatter {};
+    input::context<stream_type> call_context { istream };
+    while (true) {
+        typename ContainerType::value_type element;
+        input::invoke_parse_element(formatter, istream, element, call_context, 0);
+        if (istream.fail())
+            return false;
+        elements.push_back(std::move(element));
+        if (istream.eof())
+            return true;
+        istream >> std::ws;
+        if (istream.eof())
+            return true;
+        formatter.parse_separator(istream);
+        if (!istream.good())
+            return false;
+    }
+}
 
-        return ostream;
+/**
+ * @brief helper to from_stream, reserves space for merged elements where the
+ *   container allows
+ */
+template <typename ContainerType>
+auto reserve(ContainerType& container, const std::size_t size)
+    -> decltype(container.reserve(size))
+{
+    return container.reserve(size);
+}
+
+template <typename ContainerType, typename... Ignored>
+void reserve(ContainerType& /*container*/, const std::size_t /*size*/, Ignored...)
+{}
+
+}  // namespace detail
+
+/**
+ * @brief stream extraction of compatible container, parsing ranges of its
+ *   elements on separate threads
+ * @notes overloads as follows:
+ *   - containers with emplace_back (eg std::vector, std::deque, std::list)
+ *       extracted from a memory::basic_input_buffer: a sequential scan finds
+ *       the suffix of the container and separators between its elements to
+ *       split it into chunks, each chunk is parsed on its own thread into a
+ *       std::vector, and the vectors are merged in order, with chunks of
+ *       indexable containers parsed as by structure::from_stream
+ *   - default: sequential input::from_stream, as with operator>>
+ * @notes
+ *   - the container is only modified if extraction succeeds, otherwise
+ *       failbit is set, as with operator>>
+ *   - uses up to thread_count threads, each parsing at least
+ *       min_chunk_length chars, smaller serializations are parsed on the
+ *       calling thread with structure::from_stream, as are serializations
+ *       without a suffix, so that input cut short leaves the same stream
+ *       state as with operator>> (eg only eofbit if cut after an element)
+ */
+template <typename ContainerType, typename StreamType>
+auto from_stream(StreamType& istream, ContainerType& container,
+                 const std::size_t thread_count = std::thread::hardware_concurrency()
+    ) -> std::enable_if_t<
+    traits::is_parseable_as_container<ContainerType>::value &&
+    traits::has_emplace_back<ContainerType>::value,
+    StreamType&>
+{
+    using stream_char_type = typename StreamType::char_type;
+    using traits_type = typename StreamType::traits_type;
+    using buffer_type = memory::basic_input_buffer<stream_char_type, traits_type>;
+    using formatter_type = input::default_formatter<ContainerType, StreamType>;
+    using element_type = typename ContainerType::value_type;
+
+    auto* buffer { dynamic_cast<buffer_type*>(istream.rdbuf()) };
+    if (buffer == nullptr || thread_count < 2 ||
+        std::size_t(buffer->end() - buffer->next()) < 2 * min_chunk_length)
+        return structure::from_stream(istream, container);
+
+    const auto start { buffer->next() };
+    const formatter_type formatter {};
+    formatter.parse_prefix(istream);
+    if (!istream.good())
+        return istream;
+
+    // parse suffix to check for empty container
+    formatter.parse_suffix(istream);
+    if (!istream.bad()) {
+        if (!istream.fail()) {
+            container.clear();
+            return istream;
+        } else {
+            istream.clear();
+        }
     }
 
-    auto begin = std::begin(container);
-    formatter.print_element(ostream, *begin);
+    const auto first { buffer->next() };
+    std::vector<const stream_char_type*> boundaries;
+    const auto suffix { detail::split_elements(
+        first, buffer->end(), formatter_type::decorators.separator,
+        thread_count, boundaries) };
+    if (suffix == nullptr) {
+        // without a suffix, left to the sequential parse, for the stream state
+        //   it leaves on input cut short
+        buffer->set_next(start);
+        return structure::from_stream(istream, container);
+    }
 
-    std::advance(begin, 1);
+    const auto separator_length {
+        traits_type::length(formatter_type::decorators.separator) };
+    const auto chunk_count { boundaries.size() + 1 };
+    std::vector<std::vector<element_type>> chunks(chunk_count);
+    std::vector<std::future<bool>> tasks;
+    tasks.reserve(chunk_count);
+    for (std::size_t i {}; i < chunk_count; ++i) {
+        const auto chunk_first { i == 0 ? first : boundaries[i - 1] + separator_length };
+        const auto chunk_last { i == chunk_count - 1 ? suffix : boundaries[i] };
+        auto* elements { &chunks[i] };
+        // istream is only read from by tasks until they are all joined
+        tasks.push_back(std::async(
+            std::launch::async, [chunk_first, chunk_last, &istream, elements]() {
+                return detail::parse_chunk<ContainerType>(
+                    chunk_first, chunk_last, istream, *elements);
+            }));
+    }
+    bool parsed { true };
+    for (auto& task : tasks)
+        parsed = task.get() && parsed;
+    if (!parsed) {
+        istream.setstate(std::ios_base::failbit);
+        return istream;
+    }
 
-    std::for_each(begin, std::end(container),
-#ifdef __cpp_generic_lambdas
-                  [&ostream, &formatter](const auto& element) {
-#else
-                  [&ostream, &formatter](const decltype(*begin)& element) {
-#endif
-        formatter.print_separator(ostream);
-        formatter.print_element(ostream, element);
-    });
+    buffer->set_next(suffix);
+    formatter.parse_suffix(istream);
+    if (istream.fail())
+        return istream;
 
-    formatter.print_suffix(ostream);
+    std::size_t size {};
+    for (const auto& chunk : chunks)
+        size += chunk.size();
+    ContainerType new_container;
+    detail::reserve(new_container, size);
+    for (auto& chunk : chunks) {
+        for (auto& element : chunk)
+            new_container.emplace_back(std::move(element));
+    }
+    container = std::move(new_container);
+    return istream;
+}
 
-    return ostream;
+template <typename ContainerType, typename StreamType>
+auto from_stream(StreamType& istream, ContainerType& container,
+                 const std::size_t /*thread_count*/ = 0
+    ) -> std::enable_if_t<
+    traits::is_parseable_as_container<ContainerType>::value &&
+    !traits::has_emplace_back<ContainerType>::value,
+    StreamType&>
+{
+    using formatter_type = input::default_formatter<ContainerType, StreamType>;
+    return input::from_stream(istream, container, formatter_type{});
 }
 
-}  // namespace output
+}  // namespace parallel
 
 }  // namespace container_stream_io
 
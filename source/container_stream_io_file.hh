@@ -0,0 +1,330 @@
+#pragma once
+
+/*
+ * @file loading and saving of container serializations from and to files,
+ *   kept apart from container_stream_io.hh so that only users of load_file
+ *   and save_file include the platform headers needed for memory mapping and
+ *   unbuffered file output
+ */
+
+#include "container_stream_io.hh"
+
+#include <cerrno>       // errno
+#include <string>
+#include <system_error> // error_code, generic_category
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#define CONTAINER_STREAM_IO_HAS_MMAP
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, madvise, munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+#else
+#include <cstdio>       // fopen, fwrite, fclose
+#include <fstream>      // ifstream
+#endif
+
+namespace container_stream_io {
+
+namespace memory {
+
+namespace detail {
+
+/**
+ * @brief read-only view of a whole file, memory mapped where supported, and
+ *   otherwise read into memory
+ * @notes throws std::ios_base::failure, with the error code of the failing
+ *   call, if the file cannot be opened or mapped
+ */
+class mapped_file
+{
+public:
+    explicit mapped_file(const std::string& path)
+    {
+#ifdef CONTAINER_STREAM_IO_HAS_MMAP
+        const int fd { ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+        if (fd == -1)
+            throw_error("open", path);
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+            const int error { errno };
+            ::close(fd);
+            errno = error;
+            throw_error("fstat", path);
+        }
+        size_ = std::size_t(st.st_size);
+        if (size_ > 0) {
+            void* mapping { ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0) };
+            if (mapping == MAP_FAILED) {
+                const int error { errno };
+                ::close(fd);
+                errno = error;
+                throw_error("mmap", path);
+            }
+            // failure to advise is harmless, the mapping is still usable
+            ::madvise(mapping, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+#else
+        std::ifstream ifs { path, std::ios_base::binary };
+        if (!ifs.is_open())
+            throw_error("open", path);
+        contents_.assign(std::istreambuf_iterator<char>(ifs),
+                         std::istreambuf_iterator<char>());
+        if (ifs.bad())
+            throw_error("read", path);
+        data_ = contents_.data();
+        size_ = contents_.size();
+#endif
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+#ifdef CONTAINER_STREAM_IO_HAS_MMAP
+        if (data_ != nullptr)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    const char* data() const noexcept
+    {
+        return data_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+private:
+    [[noreturn]] static void throw_error(const char* call, const std::string& path)
+    {
+        throw std::ios_base::failure(
+            std::string("container_stream_io: ") + call + " failed for " + path,
+            std::error_code(errno, std::generic_category()));
+    }
+
+    const char* data_ {};
+    std::size_t size_ {};
+#ifndef CONTAINER_STREAM_IO_HAS_MMAP
+    std::string contents_;
+#endif
+};
+
+/**
+ * @brief size of the blocks written to files by file_output_buffer
+ */
+static constexpr std::size_t file_block_size { std::size_t(1) << 20 };
+
+/**
+ * @brief write-only stream buffer over a file, truncated on opening, that
+ *   writes in large blocks straight to the file descriptor (or C stream where
+ *   POSIX is unavailable)
+ * @notes
+ *   - throws std::ios_base::failure, with the error code of the failing
+ *       call, if the file cannot be opened
+ *   - write errors make overflow/sync fail, setting badbit on the stream,
+ *       and are thrown by close
+ */
+class file_output_buffer : public std::streambuf
+{
+public:
+    explicit file_output_buffer(const std::string& path) :
+        path_(path), block_(file_block_size)
+    {
+#ifdef CONTAINER_STREAM_IO_HAS_MMAP
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+        if (fd_ == -1)
+            throw_error("open");
+#else
+        file_ = std::fopen(path.c_str(), "wb");
+        if (file_ == nullptr)
+            throw_error("open");
+#endif
+        setp(block_.data(), block_.data() + block_.size());
+    }
+
+    file_output_buffer(const file_output_buffer&) = delete;
+    file_output_buffer& operator=(const file_output_buffer&) = delete;
+
+    ~file_output_buffer() override
+    {
+        if (is_open())
+            close_file();
+    }
+
+    /**
+     * @brief writes remaining buffered output and closes file, throwing on
+     *   any error since opening
+     */
+    void close()
+    {
+        const bool flushed { write_block() };
+        const bool closed { close_file() };
+        if (!flushed || !closed) {
+            errno = error_;
+            throw_error(flushed ? "close" : "write");
+        }
+    }
+
+protected:
+    int_type overflow(const int_type c) override
+    {
+        if (!write_block())
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            sputc(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char_type* s, const std::streamsize n) override
+    {
+        // output at least as large as a block skips the block buffer
+        if (std::size_t(n) < block_.size())
+            return std::streambuf::xsputn(s, n);
+        if (!write_block() || !write_bytes(s, std::size_t(n)))
+            return 0;
+        return n;
+    }
+
+    int sync() override
+    {
+        return write_block() ? 0 : -1;
+    }
+
+private:
+    [[noreturn]] void throw_error(const char* call) const
+    {
+        throw std::ios_base::failure(
+            std::string("container_stream_io: ") + call + " failed for " + path_,
+            std::error_code(errno, std::generic_category()));
+    }
+
+    bool is_open() const noexcept
+    {
+#ifdef CONTAINER_STREAM_IO_HAS_MMAP
+        return fd_ != -1;
+#else
+        return file_ != nullptr;
+#endif
+    }
+
+    /**
+     * @brief writes and empties the block buffer
+     */
+    bool write_block()
+    {
+        const bool written { write_bytes(pbase(), std::size_t(pptr() - pbase())) };
+        setp(block_.data(), block_.data() + block_.size());
+        return written;
+    }
+
+    bool write_bytes(const char* bytes, std::size_t count)
+    {
+        if (error_ != 0 || !is_open())
+            return false;
+#ifdef CONTAINER_STREAM_IO_HAS_MMAP
+        while (count > 0) {
+            const auto written { ::write(fd_, bytes, count) };
+            if (written == -1) {
+                if (errno == EINTR)
+                    continue;
+                error_ = errno;
+                return false;
+            }
+            bytes += written;
+            count -= std::size_t(written);
+        }
+#else
+        if (std::fwrite(bytes, 1, count, file_) != count) {
+            error_ = errno != 0 ? errno : EIO;
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    bool close_file() noexcept
+    {
+#ifdef CONTAINER_STREAM_IO_HAS_MMAP
+        const bool closed { ::close(fd_) == 0 };
+        fd_ = -1;
+#else
+        const bool closed { std::fclose(file_) == 0 };
+        file_ = nullptr;
+#endif
+        if (!closed && error_ == 0)
+            error_ = errno;
+        return closed;
+    }
+
+    std::string path_;
+    std::vector<char> block_;
+#ifdef CONTAINER_STREAM_IO_HAS_MMAP
+    int fd_ { -1 };
+#else
+    std::FILE* file_ {};
+#endif
+    int error_ {};
+};
+
+}  // namespace detail
+
+/**
+ * @brief extracts compatible container from the (text) serialization in a
+ *   file, parsing directly from a read-only memory mapping of the file
+ * @notes
+ *   - uses the same formatting as operator>>, with the default literalrepr
+ *   - throws std::ios_base::failure if the file cannot be read or does not
+ *       start with a serialization of ContainerType
+ */
+template <typename ContainerType>
+auto load_file(const std::string& path) -> std::enable_if_t<
+    traits::is_parseable_as_container<ContainerType>::value,
+    ContainerType>
+{
+    const detail::mapped_file file { path };
+    input_buffer buffer { file.data(), file.size() };
+    std::istream istream { &buffer };
+
+    ContainerType container;
+    using formatter_type = input::default_formatter<ContainerType, std::istream>;
+    input::from_stream(istream, container, formatter_type{});
+    // eof before the final suffix leaves from_stream without failbit, but also
+    //   without extracting the container
+    if (!istream.good())
+        throw std::ios_base::failure(
+            "container_stream_io: malformed serialization in " + path);
+    return container;
+}
+
+/**
+ * @brief inserts compatible container into a file (text) serialization,
+ *   replacing any previous contents of the file
+ * @notes
+ *   - uses the same formatting as operator<<, with the default literalrepr
+ *   - output is written in large blocks directly to the file, bypassing the
+ *       smaller buffer of std::ofstream
+ *   - throws std::ios_base::failure if the file cannot be opened or written
+ */
+template <typename ContainerType>
+auto save_file(const std::string& path, const ContainerType& container
+    ) -> std::enable_if_t<
+    traits::is_printable_as_container<ContainerType>::value,
+    void>
+{
+    detail::file_output_buffer buffer { path };
+    std::ostream ostream { &buffer };
+
+    using formatter_type = output::default_formatter<ContainerType, std::ostream>;
+    output::to_stream(ostream, container, formatter_type{});
+    buffer.close();
+}
+
+}  // namespace memory
+
+}  // namespace container_stream_io
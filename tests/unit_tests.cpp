@@ -30,9 +30,11 @@
 #endif
 
 #include "container_stream_io.hh"
+#include "container_stream_io_file.hh"
 
 #include <algorithm>
 #include <functional>
+#include <numeric>
 
 #include <array>
 #include <vector>
@@ -47,6 +49,10 @@
 #include <stack>
 #include <queue>
 #include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
 
 namespace
 {
@@ -135,6 +141,64 @@ struct custom_formatter
     }
 };
 
+// records sax::parse events in a compact text form, eg "[1,'a',]"
+struct recording_handler : public container_stream_io::sax::null_handler
+{
+    std::string log;
+
+    void begin_container(container_stream_io::sax::container_kind kind)
+    {
+        log += "[{(<"[static_cast<int>(kind)];
+    }
+
+    void end_container(container_stream_io::sax::container_kind kind)
+    {
+        log += "]})>"[static_cast<int>(kind)];
+    }
+
+    void integer_element(long long value)
+    {
+        log += "i" + std::to_string(value) + ",";
+    }
+
+    void unsigned_element(unsigned long long value)
+    {
+        log += "u" + std::to_string(value) + ",";
+    }
+
+    void floating_element(double value)
+    {
+        log += "f" + std::to_string(value) + ",";
+    }
+
+    template <typename CharType>
+    void char_element(CharType value)
+    {
+        log += "c" + std::to_string(sizeof(CharType)) + ":" +
+            std::to_string(static_cast<long>(value)) + ",";
+    }
+
+    template <typename CharType>
+    void string_element(const std::basic_string<CharType>& value)
+    {
+        log += "s" + std::to_string(sizeof(CharType)) + ":" +
+            std::to_string(value.size()) + ",";
+    }
+};
+
+// sums all numbers in a serialization of std::map<std::string, std::vector<double>>
+struct summing_handler : public container_stream_io::sax::null_handler
+{
+    using container_stream_io::sax::null_handler::string_element;
+
+    std::size_t keys {};
+    double sum {};
+
+    void integer_element(long long value) { sum += value; }
+    void floating_element(double value) { sum += value; }
+    void string_element(const std::string& /*key*/) { ++keys; }
+};
+
 } // namespace
 
 using namespace container_stream_io;
@@ -548,6 +612,13 @@ TEST_CASE("strings::literal() printing/output streaming escaped literals",
             REQUIRE(oss.str() == "'\\xff'");
             REQUIRE(oss.good());
         }
+
+        SECTION("hex escapes of fixed width, leaving stream format unchanged")
+        {
+            oss << std::setfill('*') << strings::literal(U'\x0001f600') << ' ' << 26
+                << ' ' << std::setw(3) << 5;
+            REQUIRE(oss.str() == "U'\\x0001f600' 26 **5");
+        }
     }
 
     SECTION("allows choosing custom escape and delimiter characters")
@@ -714,6 +785,81 @@ TEST_CASE("strings::literal() parsing/input streaming escaped literals",
         }
     }
 
+    SECTION("single chars decode with escapes and literal prefixes")
+    {
+        std::istringstream iss { R"('\n' '\x41' '\'' U'\x0001f600' u'\\' '' 'ab')" };
+        char c;
+        char32_t c32;
+        char16_t c16;
+
+        iss >> std::ws >> strings::literal(c);
+        REQUIRE(c == '\n');
+        iss >> std::ws >> strings::literal(c);
+        REQUIRE(c == 'A');
+        iss >> std::ws >> strings::literal(c);
+        REQUIRE(c == '\'');
+        iss >> std::ws >> strings::literal(c32);
+        REQUIRE(c32 == U'\x0001f600');
+        iss >> std::ws >> strings::literal(c16);
+        REQUIRE(c16 == u'\\');
+        REQUIRE(!iss.fail());
+
+        iss >> std::ws >> strings::literal(c);
+        REQUIRE(iss.fail());
+        REQUIRE(c == '\'');
+
+        iss.clear();
+        iss >> std::ws >> strings::literal(c);
+        REQUIRE(iss.fail());
+        REQUIRE(c == '\'');
+    }
+
+    SECTION("hex escapes decode exactly as many digits as the char type width")
+    {
+        std::istringstream iss { R"(U"\x0001F600\x0001f600" "\xAb1" "\x1g" "\x1)" };
+        std::u32string s32;
+        std::string s;
+
+        iss >> std::ws >> strings::literal(s32);
+        REQUIRE(s32 == U"\x0001f600\x0001f600");
+        iss >> std::ws >> strings::literal(s);
+        REQUIRE(s == "\xab" "1");
+        REQUIRE(!iss.fail());
+
+        iss >> std::ws >> strings::literal(s);
+        REQUIRE(iss.fail());
+        REQUIRE(!iss.eof());
+
+        iss.clear();
+        iss.ignore(2);
+        iss >> std::ws >> strings::literal(s);
+        REQUIRE(iss.fail());
+        REQUIRE(iss.eof());
+        REQUIRE(s == "\xab" "1");
+    }
+
+    SECTION("successive strings decode independently of each other")
+    {
+        std::istringstream iss { "\"longer\" \"s\" 'c' 'cc' \"unterminated" };
+        std::string s;
+        char c;
+
+        iss >> std::ws >> strings::literal(s);
+        REQUIRE(s == "longer");
+        iss >> std::ws >> strings::literal(s);
+        REQUIRE(s == "s");
+        iss >> std::ws >> strings::literal(c);
+        REQUIRE(c == 'c');
+        iss >> std::ws >> strings::literal(c);
+        REQUIRE(iss.fail());
+        REQUIRE(c == 'c');
+
+        iss.clear();
+        iss >> std::ws >> strings::literal(s);
+        REQUIRE(iss.fail());
+        REQUIRE(s == "s");
+    }
+
     SECTION("only expects printable 7-bit ASCII to decode")
     {
         std::istringstream iss;
@@ -1415,6 +1561,51 @@ TEST_CASE("Strings: printing/output streaming string types inside compatible "
         oss << vs;
         REQUIRE(oss.str() == "[\"tes\\t\"]");
     }
+
+    SECTION("read once per top-level call, from the stream it is passed")
+    {
+        using formatter_type =
+            container_stream_io::output::default_formatter<
+                std::vector<std::string>, std::ostringstream>;
+        const formatter_type formatter {};
+        std::vector<std::string> vs { { "tes\t" } };
+        std::ostringstream quoted_oss, literal_oss;
+        quoted_oss << strings::quotedrepr;
+        container_stream_io::output::to_stream(quoted_oss, vs, formatter);
+        container_stream_io::output::to_stream(literal_oss, vs, formatter);
+        REQUIRE(quoted_oss.str() == "[\"tes\t\"]");
+        REQUIRE(literal_oss.str() == "[\"tes\\t\"]");
+    }
+
+    SECTION("nested levels use repr of call context, not of stream")
+    {
+        using nested_type = std::vector<std::vector<std::string>>;
+        const nested_type vvs { { "tes\t" }, { "a", "\tb" } };
+
+        std::ostringstream oss;
+        oss << strings::quotedrepr;
+        container_stream_io::output::context<std::ostringstream> out_context { oss };
+        out_context.repr = container_stream_io::strings::detail::repr_type::literal;
+        container_stream_io::output::to_stream(
+            oss, vvs,
+            container_stream_io::output::default_formatter<
+                nested_type, std::ostringstream>{},
+            out_context);
+        REQUIRE(oss.str() == R"([["tes\t"], ["a", "\tb"]])");
+
+        // raw tabs only decode with quoted
+        std::istringstream iss { "[[\"tes\t\"], [\"a\", \"\tb\"]]" };
+        container_stream_io::input::context<std::istringstream> in_context { iss };
+        in_context.repr = container_stream_io::strings::detail::repr_type::quoted;
+        nested_type vvs2;
+        container_stream_io::input::from_stream(
+            iss, vvs2,
+            container_stream_io::input::default_formatter<
+                nested_type, std::istringstream>{},
+            in_context);
+        REQUIRE(!iss.fail());
+        REQUIRE(vvs2 == vvs);
+    }
 }
 
 TEST_CASE("Strings: parsing/input streaming string types inside compatible "
@@ -1482,6 +1673,173 @@ TEST_CASE("Strings: parsing/input streaming string types inside compatible "
     }
 }
 
+TEST_CASE("Strings: literal encoding with differing string and stream char types",
+          "[literal][strings][output][input]")
+{
+    // runs long enough to span several blocks of any char size, with
+    //   escapes and delimiters inside and at the ends of blocks
+    const std::string plain (37, 'x');
+
+    SECTION("narrowing wider strings")
+    {
+        const std::u16string s16 { std::u16string(37, u'x') + u"\u00e9" +
+                                   std::u16string(37, u'x') + u"\"" };
+        const std::u32string s32 { std::u32string(37, U'x') + U"\t" +
+                                   std::u32string(37, U'x') + U"\U0001f600" };
+        std::ostringstream oss;
+        oss << std::make_tuple(s16, s32);
+        REQUIRE(oss.str() == "<u\"" + plain + "\\x00e9" + plain + "\\\"\", U\"" +
+                plain + "\\t" + plain + "\\x0001f600\">");
+    }
+
+    SECTION("widening narrower strings")
+    {
+        const std::string s { plain + "\x01" + plain + "\\" };
+        const std::wstring wplain (37, L'x');
+        std::wostringstream woss;
+        woss << std::vector<std::string> { s, plain };
+        REQUIRE(woss.str() == L"[\"" + wplain + L"\\x01" + wplain + L"\\\\\", \"" +
+                wplain + L"\"]");
+    }
+
+    SECTION("parsing from memory buffers, as from other stream buffers")
+    {
+        const std::u16string s16 { std::u16string(37, u'x') + u"\u00e9" +
+                                   std::u16string(37, u'x') + u"\"" };
+        const std::string s { plain + "\x01" + plain + "\\" };
+        std::ostringstream oss;
+        oss << std::make_tuple(s16, s) << std::vector<std::string> { plain, s };
+        const auto text { oss.str() };
+        std::wostringstream woss;
+        woss << std::vector<std::string> { s, plain };
+        const auto wtext { woss.str() };
+
+        container_stream_io::memory::input_buffer buffer { text.data(), text.size() };
+        std::istream is { &buffer };
+        std::tuple<std::u16string, std::string> t;
+        std::vector<std::string> v;
+        is >> t >> v;
+        REQUIRE(!is.fail());
+        REQUIRE(t == std::make_tuple(s16, s));
+        REQUIRE(v == std::vector<std::string> { plain, s });
+
+        container_stream_io::memory::basic_input_buffer<wchar_t> wbuffer {
+            wtext.data(), wtext.size() };
+        std::wistream wis { &wbuffer };
+        std::vector<std::string> wv;
+        wis >> wv;
+        REQUIRE(!wis.fail());
+        REQUIRE(wv == std::vector<std::string> { s, plain });
+
+        const std::string bad { "[\"" + plain + "\t\"]" };
+        container_stream_io::memory::input_buffer bad_buffer { bad.data(), bad.size() };
+        std::istream bad_is { &bad_buffer };
+        std::vector<std::string> bad_v;
+        bad_is >> bad_v;
+        REQUIRE(bad_is.fail());
+    }
+}
+
+TEST_CASE("Strings: utf8repr passes well-formed UTF-8 through literal encoding",
+          "[literal][strings][output][input]")
+{
+    // "é", "€", "😀" as UTF-8
+    const std::string text { "a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80" };
+
+    SECTION("printing leaves well-formed sequences unescaped")
+    {
+        std::ostringstream oss;
+        oss << strings::utf8repr << std::vector<std::string> { text, "\"\t" };
+        REQUIRE(oss.str() == "[\"" + text + "\", \"\\\"\\t\"]");
+    }
+
+#if __cplusplus > 201703L
+    SECTION("printing char8_t strings to char streams likewise")
+    {
+        std::ostringstream oss;
+        oss << strings::utf8repr << std::vector<std::u8string> { u8"a\u00e9", { char8_t(0xff) } };
+        REQUIRE(oss.str() == "[u8\"a\xc3\xa9\", u8\"\\xff\"]");
+    }
+#endif
+
+    SECTION("printing escapes invalid bytes, overlongs, surrogates, and truncations")
+    {
+        std::ostringstream oss;
+        oss << strings::utf8repr << std::vector<std::string> {
+            "\xc0\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xe2\x82", "\x80" };
+        REQUIRE(oss.str() == R"(["\xc0\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", )"
+                             R"("\xe2\x82", "\x80"])");
+    }
+
+    SECTION("printing chars and wider strings as with literalrepr")
+    {
+        std::ostringstream oss;
+        oss << strings::utf8repr << std::make_tuple('\xc3', std::u32string { U"\u00e9" });
+        REQUIRE(oss.str() == R"(<'\xc3', U"\x000000e9">)");
+    }
+
+    SECTION("printing long runs, with escapes past SIMD block boundaries")
+    {
+        const std::string plain (40, 'x');
+        std::ostringstream oss;
+        oss << strings::utf8repr << std::vector<std::string> {
+            plain + "\n" + plain + "\xc3\xa9" + plain + "\"" };
+        REQUIRE(oss.str() == "[\"" + plain + "\\n" + plain + "\xc3\xa9" + plain +
+                "\\\"\"]");
+    }
+
+    SECTION("printing long multi-byte runs, with ill-formed sequences at each block offset")
+    {
+        const std::pair<std::string, std::string> ill_formed[] {
+            { "\xc0\xaf", R"(\xc0\xaf)" }, { "\xed\xa0\x80", R"(\xed\xa0\x80)" },
+            { "\xf4\x90\x80\x80", R"(\xf4\x90\x80\x80)" }, { "\xe2\x82", R"(\xe2\x82)" },
+            { "\x80", R"(\x80)" }, { "\x7f", R"(\x7f)" } };
+        for (std::size_t offset {}; offset < 32; ++offset)
+        {
+            for (const auto& bytes : ill_formed)
+            {
+                const std::string head { std::string(offset, 'x') + text + text };
+                std::ostringstream oss;
+                oss << strings::utf8repr << std::vector<std::string> {
+                    head + bytes.first + text, head + "\xe2\x82" };
+                REQUIRE(oss.str() == "[\"" + head + bytes.second + text + "\", \"" +
+                        head + "\\xe2\\x82\"]");
+            }
+        }
+    }
+
+    SECTION("parsing accepts both unescaped sequences and escapes")
+    {
+        std::istringstream iss { "[\"" + text + "\", \"\\xc3\\xa9\"]" };
+        iss >> strings::utf8repr;
+        std::vector<std::string> vs;
+        iss >> vs;
+        REQUIRE(!iss.fail());
+        REQUIRE(vs == std::vector<std::string> { text, "\xc3\xa9" });
+    }
+
+    SECTION("parsing fails on ill-formed sequences")
+    {
+        for (const auto* s : { "[\"\xc0\xaf\"]", "[\"\xed\xa0\x80\"]",
+                               "[\"\xe2\x82\"]", "[\"\x80\"]" })
+        {
+            std::istringstream iss { s };
+            iss >> strings::utf8repr;
+            std::vector<std::string> vs;
+            iss >> vs;
+            REQUIRE(iss.fail());
+        }
+    }
+
+    SECTION("literalrepr still rejects unescaped sequences")
+    {
+        std::istringstream iss { "[\"" + text + "\"]" };
+        std::vector<std::string> vs;
+        iss >> vs;
+        REQUIRE(iss.fail());
+    }
+}
+
 TEST_CASE("Delimiters: validate char defaults for", "[decorator]")
 {
     SECTION("non-specialized container type")
@@ -1734,6 +2092,87 @@ TEST_CASE("Delimiters: validate char32_t defaults for", "[decorator]")
     }
 }
 
+// container type with non-default delimiters, for decorator tests only
+struct piped_container
+{};
+
+namespace container_stream_io {
+namespace decorator {
+
+template <typename CharType>
+struct delimiters<piped_container, CharType>
+{
+    static constexpr delim_wrapper<CharType> values {
+        STRING_LITERAL(CharType, "<<"),
+        STRING_LITERAL(CharType, " |"),
+        STRING_LITERAL(CharType, "  "),
+        STRING_LITERAL(CharType, ">>") };
+};
+
+}  // namespace decorator
+}  // namespace container_stream_io
+
+TEST_CASE("Delimiters: lengths and fused separator", "[decorator]")
+{
+    SECTION("default delimiters")
+    {
+        using container_stream_io::decorator::delimiters;
+        using container_stream_io::decorator::fused_separator;
+        constexpr auto values { delimiters<std::vector<int>, wchar_t>::values };
+        static_assert(values.prefix_length == 1 && values.separator_length == 1 &&
+                      values.whitespace_length == 1 && values.suffix_length == 1,
+                      "lengths of default delimiters");
+        static_assert(fused_separator<std::vector<int>, wchar_t>::length == 2,
+                      "length of default fused separator");
+        REQUIRE(idiomatic_strcmp(
+            fused_separator<std::vector<int>, wchar_t>::value.chars, L", "));
+    }
+
+    SECTION("specialized delimiters")
+    {
+        using fused_type = container_stream_io::decorator::fused_separator<
+            piped_container, char16_t>;
+        static_assert(fused_type::decorators.prefix_length == 2, "prefix length");
+        static_assert(fused_type::length == 4, "fused separator length");
+        REQUIRE(idiomatic_strcmp(fused_type::value.chars, u" |  "));
+    }
+
+    SECTION("separators inserted and extracted as with individual tokens")
+    {
+        std::ostringstream oss;
+        oss << std::vector<std::set<int>> { { 1, 2 }, {}, { 3 } };
+        REQUIRE(oss.str() == "[{1, 2}, {}, {3}]");
+        std::istringstream iss { "[ {1 ,2},{},  {3}]" };
+        std::vector<std::set<int>> v;
+        iss >> v;
+        REQUIRE(!iss.fail());
+        REQUIRE(v == std::vector<std::set<int>> { { 1, 2 }, {}, { 3 } });
+    }
+
+    SECTION("single char tokens with pending field width or unitbuf")
+    {
+        std::ostringstream oss;
+        oss << std::setw(3) << std::vector<int> { 1, 2 };
+        REQUIRE(oss.str() == "  [1, 2]");
+        oss.str("");
+        oss << std::unitbuf << std::make_pair(1, 2);
+        REQUIRE(oss.str() == "(1, 2)");
+    }
+
+    SECTION("single char tokens after whitespace or at end of stream")
+    {
+        std::istringstream iss { " \t[ ( 1 , 2 ) ]" };
+        std::vector<std::pair<int, int>> v;
+        iss >> v;
+        REQUIRE(!iss.fail());
+        REQUIRE(v == std::vector<std::pair<int, int>> { { 1, 2 } });
+
+        std::istringstream truncated { "[(1, 2) " };
+        truncated >> v;
+        REQUIRE(truncated.fail());
+    }
+}
+
 TEST_CASE("Printing/output streaming non-nested container types",
           "[output]")
 {
@@ -2686,6 +3125,109 @@ TEST_CASE("Printing with custom formatter",
     }
 }
 
+namespace
+{
+
+// prints with the nesting depth of each container, its hooks taking the call
+//   context (apart from print_separator, to check mixing with those without)
+struct depth_formatter
+{
+    template <typename StreamType, typename ContextType>
+    void print_prefix(StreamType& stream, ContextType& context) const
+    {
+        stream << '<' << context.depth << ':';
+    }
+
+    template <typename StreamType, typename ElementType, typename ContextType>
+    auto print_element(StreamType& stream, const ElementType& element,
+                       ContextType& /*context*/) const -> std::enable_if_t<
+        !container_stream_io::traits::is_printable_as_container<ElementType>::value,
+        void>
+    {
+        stream << std::string(static_cast<std::size_t>(element), '*');
+    }
+
+    template <typename StreamType, typename ElementType, typename ContextType>
+    auto print_element(StreamType& stream, const ElementType& element,
+                       ContextType& context) const -> std::enable_if_t<
+        container_stream_io::traits::is_printable_as_container<ElementType>::value,
+        void>
+    {
+        ++context.depth;
+        container_stream_io::output::to_stream(stream, element, *this, context);
+        --context.depth;
+    }
+
+    template <typename StreamType>
+    void print_separator(StreamType& stream) const
+    {
+        stream << ',';
+    }
+
+    template <typename StreamType, typename ContextType>
+    void print_suffix(StreamType& stream, ContextType& /*context*/) const
+    {
+        stream << '>';
+    }
+};
+
+// parses integer elements, negated when the call context has quoted repr
+template <typename ContainerType>
+struct negating_formatter :
+    container_stream_io::input::default_formatter<ContainerType, std::istream>
+{
+    template <typename ContextType>
+    static void parse_element(std::istream& istream, int& element,
+                              ContextType& context)
+    {
+        istream >> std::ws >> element;
+        if (context.repr == container_stream_io::strings::detail::repr_type::quoted)
+            element = -element;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Formatters with call context",
+          "[output][input]")
+{
+    SECTION("hooks taking context are detected, and mixed with those without")
+    {
+        std::ostringstream oss;
+        const std::vector<std::vector<int>> container { { 1, 2 }, {}, { 3 } };
+        container_stream_io::output::to_stream(oss, container, depth_formatter{});
+        REQUIRE(oss.str() == "<0:<1:*,**>,<1:>,<1:***>>");
+    }
+
+    SECTION("context is shared by nesting levels of default formatter")
+    {
+        std::ostringstream oss;
+        const std::vector<std::vector<std::string>> container { { "a" }, { "b", "c" } };
+        using formatter_type = container_stream_io::output::default_formatter<
+            std::vector<std::vector<std::string>>, std::ostringstream>;
+        container_stream_io::output::context<std::ostringstream> context { oss };
+        context.repr = container_stream_io::strings::detail::repr_type::quoted;
+        container_stream_io::output::to_stream(
+            oss, container, formatter_type{}, context);
+        REQUIRE(oss.str() == R"([["a"], ["b", "c"]])");
+        REQUIRE(context.depth == 0);
+    }
+
+    SECTION("context passed explicitly reaches input hooks")
+    {
+        std::istringstream iss { "[12, 345, 6789]" };
+        std::istream& istream { iss };
+        std::vector<int> container;
+        container_stream_io::input::context<std::istream> context { istream };
+        context.repr = container_stream_io::strings::detail::repr_type::quoted;
+        container_stream_io::input::from_stream(
+            istream, container, negating_formatter<std::vector<int>>{}, context);
+        REQUIRE(!iss.fail());
+        REQUIRE(container == std::vector<int>{ -12, -345, -6789 });
+        REQUIRE(context.depth == 0);
+    }
+}
+
 TEST_CASE("Exploring edge cases for nested containers",
           "[output][input]")
 {
@@ -2757,3 +3299,1362 @@ TEST_CASE("Exploring edge cases for nested containers",
         }
     }
 }
+
+TEST_CASE("SAX parsing of container serializations",
+          "[input][sax]")
+{
+    SECTION("reports container boundaries and typed elements in order")
+    {
+        std::istringstream iss {
+            "[(-1, 18446744073709551615), {1.5, 'a'}, <\"s\", U\"tu\">, []]" };
+        recording_handler handler;
+        sax::parse(iss, handler);
+        REQUIRE(!iss.fail());
+        REQUIRE(handler.log ==
+                "[(i-1,u18446744073709551615,){f1.500000,c1:97,}"
+                "<s1:1,s4:2,>[]]");
+    }
+
+    SECTION("decodes string elements according to stream repr")
+    {
+        recording_handler handler;
+
+        SECTION("literal")
+        {
+            std::istringstream iss { "[\"a\\tb\", L'\\x00000041']" };
+            sax::parse(iss, handler);
+            REQUIRE(!iss.fail());
+            REQUIRE(handler.log == "[s1:3,c4:65,]");
+        }
+
+        SECTION("quoted")
+        {
+            std::istringstream iss { "[\"a\\\"]\"]" };
+            iss >> strings::quotedrepr;
+            sax::parse(iss, handler);
+            REQUIRE(!iss.fail());
+            REQUIRE(handler.log == "[s1:3,]");
+        }
+    }
+
+    SECTION("aggregates nested maps without materializing them")
+    {
+        std::map<std::string, std::vector<double>> m {
+            { "a", { 1.5, 2.5 } }, { "b", {} }, { "c", { -4, 10 } } };
+        std::stringstream ss;
+        ss << m;
+        summing_handler handler;
+        sax::parse(ss, handler);
+        REQUIRE(!ss.fail());
+        REQUIRE(handler.keys == 3);
+        REQUIRE(handler.sum == 10.0);
+    }
+
+    SECTION("sets failbit on malformed serializations")
+    {
+        summing_handler handler;
+
+        SECTION("mismatched suffix")
+        {
+            std::istringstream iss { "[1, 2)" };
+            sax::parse(iss, handler);
+            REQUIRE(iss.fail());
+        }
+
+        SECTION("missing suffix")
+        {
+            std::istringstream iss { "[1, [2]" };
+            sax::parse(iss, handler);
+            REQUIRE(iss.fail());
+        }
+
+        SECTION("missing separator")
+        {
+            std::istringstream iss { "[1 2]" };
+            sax::parse(iss, handler);
+            REQUIRE(iss.fail());
+        }
+
+        SECTION("malformed number")
+        {
+            std::istringstream iss { "[1.2.3]" };
+            sax::parse(iss, handler);
+            REQUIRE(iss.fail());
+        }
+
+        SECTION("top level element not a container")
+        {
+            std::istringstream iss { "1" };
+            sax::parse(iss, handler);
+            REQUIRE(iss.fail());
+        }
+    }
+}
+
+TEST_CASE("Validating serializations without extracting containers",
+          "[input][validate]")
+{
+    SECTION("accepts serializations that operator>> would extract")
+    {
+        SECTION("non-nested")
+        {
+            std::istringstream iss { "[1, 2, 3]" };
+            REQUIRE(input::validate<std::vector<int>>(iss));
+        }
+
+        SECTION("unpopulated")
+        {
+            std::istringstream iss { "{}" };
+            REQUIRE(input::validate<std::set<int>>(iss));
+        }
+
+        SECTION("nested, with string elements")
+        {
+            std::map<std::string, std::vector<double>> m {
+                { "a\t\"", { 1.5, 2.5 } }, { "b", {} } };
+            std::stringstream ss;
+            ss << m;
+            REQUIRE(input::validate<std::map<std::string, std::vector<double>>>(ss));
+        }
+
+        SECTION("pairs, tuples, char elements and C arrays")
+        {
+            std::istringstream iss {
+                "[(<'a', U\"\\x00000041\">, [\"ab\", \"c\"])]" };
+            REQUIRE(input::validate<std::vector<std::pair<
+                    std::tuple<char, std::u32string>, char[2][3]>>>(iss));
+        }
+
+        SECTION("quoted strings")
+        {
+            std::istringstream iss { "[\"a\\\"\\\\\"]" };
+            iss >> strings::quotedrepr;
+            REQUIRE(input::validate<std::vector<std::string>>(iss));
+        }
+
+        SECTION("leaving stream positioned after serialization")
+        {
+            std::istringstream iss { "[1, 2] [3]" };
+            std::vector<int> v;
+            REQUIRE(input::validate<std::vector<int>>(iss));
+            iss >> v;
+            REQUIRE(v == std::vector<int>{ 3 });
+        }
+    }
+
+    SECTION("rejects serializations that operator>> would not extract")
+    {
+        SECTION("std::array of wrong length")
+        {
+            std::istringstream short_iss { "[1, 2]" };
+            REQUIRE(!input::validate<std::array<int, 3>>(short_iss));
+            REQUIRE(short_iss.fail());
+            std::istringstream long_iss { "[1, 2, 3, 4]" };
+            REQUIRE(!input::validate<std::array<int, 3>>(long_iss));
+        }
+
+        SECTION("invalid literal escape")
+        {
+            std::istringstream iss { "[\"\\q\"]" };
+            REQUIRE(!input::validate<std::vector<std::string>>(iss));
+        }
+
+        SECTION("truncated hex escape")
+        {
+            std::istringstream iss { "[u\"\\x04\"]" };
+            REQUIRE(!input::validate<std::vector<std::u16string>>(iss));
+        }
+
+        SECTION("char element of more than one char")
+        {
+            std::istringstream iss { "['ab']" };
+            REQUIRE(!input::validate<std::vector<char>>(iss));
+        }
+
+        SECTION("C array string that does not fit")
+        {
+            std::istringstream iss { "[\"abc\"]" };
+            REQUIRE(!input::validate<char[1][3]>(iss));
+        }
+
+        SECTION("wrong decorators")
+        {
+            std::istringstream iss { "[1, 2]" };
+            REQUIRE(!input::validate<std::set<int>>(iss));
+        }
+
+        SECTION("truncated serialization")
+        {
+            std::istringstream iss { "[[1], [2" };
+            REQUIRE(!input::validate<std::vector<std::vector<int>>>(iss));
+            REQUIRE(iss.fail());
+        }
+    }
+}
+
+TEST_CASE("Iterating over elements of a serialized container",
+          "[input][iterator]")
+{
+    using input::istream_container_iterator;
+
+    SECTION("yields elements in order, then compares equal to end")
+    {
+        std::istringstream iss { "[1, 2, 3, 4]" };
+        istream_container_iterator<std::vector<int>> it { iss }, end;
+        REQUIRE(std::accumulate(it, end, 0) == 10);
+        REQUIRE(iss.good());
+    }
+
+    SECTION("uses decorators of container type")
+    {
+        std::istringstream iss { "{\"a\", \"b\\t\"}" };
+        std::vector<std::string> v;
+        for (const auto& s : input::elements_from_stream<std::set<std::string>>(iss))
+            v.push_back(s);
+        REQUIRE(v == std::vector<std::string>{ "a", "b\t" });
+    }
+
+    SECTION("supports nested container elements")
+    {
+        std::map<std::string, std::vector<int>> m {
+            { "a", { 1, 2 } }, { "b", { 3 } } };
+        std::stringstream ss;
+        ss << m;
+        std::size_t count {};
+        for (const auto& kv : input::elements_from_stream<decltype(m)>(ss))
+            count += kv.second.size();
+        REQUIRE(count == 3);
+    }
+
+    SECTION("decodes strings with repr set on stream at each increment")
+    {
+        std::istringstream iss { "[\"\\t\", \"\t\"]" };
+        istream_container_iterator<std::vector<std::string>> it { iss };
+        REQUIRE(*it == "\t");
+        iss >> container_stream_io::strings::quotedrepr;
+        REQUIRE(*++it == "\t");
+    }
+
+    SECTION("is end immediately for unpopulated container")
+    {
+        std::istringstream iss { "[]" };
+        istream_container_iterator<std::vector<int>> it { iss };
+        REQUIRE(it == istream_container_iterator<std::vector<int>>{});
+        REQUIRE(iss.good());
+    }
+
+    SECTION("sets failbit and becomes end on malformed serialization")
+    {
+        std::istringstream iss { "[1, 2; 3]" };
+        istream_container_iterator<std::vector<int>> it { iss }, end;
+        REQUIRE(*it == 1);
+        REQUIRE(*++it == 2);
+        REQUIRE(++it == end);
+        REQUIRE(iss.fail());
+    }
+}
+
+namespace {
+
+template <typename ContainerType>
+struct skipping_formatter :
+    container_stream_io::input::default_formatter<ContainerType, std::istream>
+{
+    template <typename ElementType>
+    static void parse_element(std::istream& istream, ElementType& /*element*/)
+    {
+        container_stream_io::input::skip_element(istream);
+    }
+};
+
+// skips first element of s, with both the generic and memory buffer paths
+std::pair<std::string, std::string> skip_first(const std::string& s,
+                                               const char* separator = ",")
+{
+    std::istringstream iss { s };
+    container_stream_io::input::skip_element(iss, separator);
+    container_stream_io::memory::input_buffer buffer { s.data(), s.size() };
+    std::istream is { &buffer };
+    container_stream_io::input::skip_element(is, separator);
+    const auto rest = [](std::istream& istream) {
+        if (istream.fail())
+            return std::string { "<fail>" };
+        istream.clear();
+        return std::string { std::istreambuf_iterator<char> { istream }, {} };
+    };
+    return { rest(iss), rest(is) };
+}
+
+}  // namespace
+
+TEST_CASE("Skipping elements without decoding",
+          "[input][skip]")
+{
+    using result_type = std::pair<std::string, std::string>;
+
+    SECTION("scalars stop before separator or suffix")
+    {
+        REQUIRE(skip_first("  12.5, 3]") == result_type { ", 3]", ", 3]" });
+        REQUIRE(skip_first("x)") == result_type { ")", ")" });
+        REQUIRE(skip_first("42") == result_type { "", "" });
+    }
+
+    SECTION("containers stop after their suffix")
+    {
+        REQUIRE(skip_first("[1, {2, <3>}, (4, [5])] , 6") ==
+                result_type { " , 6", " , 6" });
+    }
+
+    SECTION("strings and chars are skipped with their escapes")
+    {
+        REQUIRE(skip_first("\"a, ]\\\"[\", 'b'") ==
+                result_type { ", 'b'", ", 'b'" });
+        REQUIRE(skip_first("['\\'', \"}\"], 1") == result_type { ", 1", ", 1" });
+        REQUIRE(skip_first("L\"\\\\\"; 1", ";") == result_type { "; 1", "; 1" });
+    }
+
+    SECTION("fails within strings or containers")
+    {
+        REQUIRE(skip_first("\"a, b") == result_type { "<fail>", "<fail>" });
+        REQUIRE(skip_first("[1, [2]") == result_type { "<fail>", "<fail>" });
+    }
+
+    SECTION("usable by custom formatters")
+    {
+        std::istringstream iss { "[1, [2, \"]\"], 'x', (3, 4)] tail" };
+        std::vector<int> v;
+        container_stream_io::input::from_stream(
+            iss, v, skipping_formatter<std::vector<int>>{});
+        REQUIRE(!iss.fail());
+        REQUIRE(v.size() == 4);
+        std::string rest;
+        iss >> rest;
+        REQUIRE(rest == "tail");
+    }
+}
+
+TEST_CASE("Scanning structural tokens of serializations",
+          "[input][structure]")
+{
+    using container_stream_io::structure::token;
+    using container_stream_io::structure::token_type;
+
+    const auto types_of = [](const std::vector<token>& tokens) {
+        std::string types;
+        for (const auto& t : tokens)
+            types += t.type == token_type::prefix ? '<' :
+                t.type == token_type::suffix ? '>' : ',';
+        return types;
+    };
+
+    SECTION("finds decorators outside of strings and chars")
+    {
+        const std::string s { "[(\"a, ]\", {'}'}), (\"\\\"[\", {})]" };
+        std::vector<token> tokens;
+        REQUIRE(container_stream_io::structure::index(
+            s.data(), s.data() + s.size(), ", ", tokens));
+        REQUIRE(types_of(tokens) == "<<,<>>,<,<>>>");
+        REQUIRE(tokens[2].offset == s.find(", {"));
+        REQUIRE(tokens.back().offset == s.size() - 1);
+    }
+
+    SECTION("matches whole separator token")
+    {
+        const std::string s { "[1,2; 3|| 4]" };
+        std::vector<token> tokens;
+        REQUIRE(container_stream_io::structure::index(
+            s.data(), s.data() + s.size(), "||", tokens));
+        REQUIRE(types_of(tokens) == "<,>");
+        REQUIRE(tokens[1].offset == s.find("||"));
+    }
+
+    SECTION("finds tokens across blocks")
+    {
+        std::vector<std::pair<std::string, std::set<char>>> v;
+        for (int i {}; i < 500; ++i)
+            v.emplace_back(std::string(std::size_t(i % 70), i % 2 ? '[' : '\\'),
+                           std::set<char> { char('#' + i % 90), '"' });
+        std::ostringstream oss;
+        oss << container_stream_io::strings::quotedrepr << v;
+        const auto s { oss.str() };
+        std::vector<token> tokens;
+        REQUIRE(container_stream_io::structure::index(
+            s.data(), s.data() + s.size(), ", ", tokens));
+        REQUIRE(tokens.size() == 2 + 500 * 7 - 1);
+        REQUIRE(std::count_if(tokens.begin(), tokens.end(), [&](const token& t) {
+            return t.type == token_type::prefix &&
+                s[t.offset] == '(' && s[t.offset + 1] == '"';
+        }) == 500);
+    }
+
+    SECTION("supports wide chars")
+    {
+        const std::wstring s { L"{(L'x', [1, 2])}" };
+        std::vector<token> tokens;
+        REQUIRE(container_stream_io::structure::index(
+            s.data(), s.data() + s.size(), L", ", tokens));
+        REQUIRE(types_of(tokens) == "<<,<,>>>");
+    }
+
+    SECTION("fails in unterminated strings")
+    {
+        const std::string s { "[\"a\", \"b\\\"]" };
+        std::vector<token> tokens;
+        REQUIRE_FALSE(container_stream_io::structure::index(
+            s.data(), s.data() + s.size(), ", ", tokens));
+    }
+}
+
+TEST_CASE("Parsing containers by their structural tokens",
+          "[input][structure]")
+{
+    using container_stream_io::memory::input_buffer;
+
+    SECTION("same as operator>> for numeric sequence containers")
+    {
+        std::vector<std::deque<long long>> v;
+        for (int i {}; i < 1000; ++i)
+            v.emplace_back(std::size_t(i % 4), (i - 500) * 1000003LL);
+        v.emplace_back(std::deque<long long> {
+                std::numeric_limits<long long>::min(),
+                std::numeric_limits<long long>::max() });
+        std::ostringstream oss;
+        oss << v << " trailing";
+        const auto s { oss.str() };
+        input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        std::vector<std::deque<long long>> v2 { { 1 } };
+        container_stream_io::structure::from_stream(is, v2);
+        REQUIRE(!is.fail());
+        REQUIRE(v2 == v);
+        std::string rest;
+        is >> rest;
+        REQUIRE(rest == "trailing");
+
+        const std::string ws { " [ [ ], [-1 ,  2 ] ]" };
+        input_buffer ws_buffer { ws.data(), ws.size() };
+        std::istream ws_is { &ws_buffer };
+        std::list<std::vector<short>> l;
+        container_stream_io::structure::from_stream(ws_is, l);
+        REQUIRE(!ws_is.fail());
+        REQUIRE(l == std::list<std::vector<short>> { {}, { -1, 2 } });
+    }
+
+#ifdef __cpp_lib_to_chars
+    SECTION("floating point elements")
+    {
+        const std::string s { "[1.5, -0.25, 1e+10, .5, 5., 4.9e-324]" };
+        input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        std::vector<double> v;
+        container_stream_io::structure::from_stream(is, v);
+        REQUIRE(!is.fail());
+        std::istringstream iss { s };
+        std::vector<double> v2;
+        iss >> v2;
+        REQUIRE(v == v2);
+    }
+
+#endif  // __cpp_lib_to_chars
+    SECTION("falls back on operator>> for input not parsed by stage two")
+    {
+        for (const std::string s : { "[+1, 2]", "[-1]", "[10, ff]" }) {
+            for (const bool hex : { false, true }) {
+                input_buffer buffer { s.data(), s.size() };
+                std::istream is { &buffer };
+                std::istringstream iss { s };
+                if (hex) {
+                    is >> std::hex;
+                    iss >> std::hex;
+                }
+                std::vector<unsigned short> v;
+                container_stream_io::structure::from_stream(is, v);
+                std::vector<unsigned short> v2;
+                iss >> v2;
+                REQUIRE(is.fail() == iss.fail());
+                REQUIRE(v == v2);
+            }
+        }
+
+        const std::string s { "{(1, \"a, b\")}" };
+        input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        std::set<std::pair<int, std::string>> st;
+        container_stream_io::structure::from_stream(is, st);
+        REQUIRE(!is.fail());
+        REQUIRE(st == std::set<std::pair<int, std::string>> { { 1, "a, b" } });
+    }
+
+    SECTION("sets failbit on malformed serializations")
+    {
+        for (const std::string s : { "[1, ]", "[1 2]", "[[1], 2]",
+                                     "[2147483648]", "[\"1\"]", "[1, [2]]" }) {
+            input_buffer buffer { s.data(), s.size() };
+            std::istream is { &buffer };
+            std::vector<int> v { 0 };
+            container_stream_io::structure::from_stream(is, v);
+            REQUIRE(is.fail());
+            REQUIRE(v == std::vector<int> { 0 });
+        }
+    }
+
+    SECTION("other stream buffers")
+    {
+        std::istringstream iss { "[[1, 2], [3]]" };
+        std::vector<std::vector<int>> v;
+        container_stream_io::structure::from_stream(iss, v);
+        REQUIRE(!iss.fail());
+        REQUIRE(v == std::vector<std::vector<int>> { { 1, 2 }, { 3 } });
+    }
+}
+
+#ifdef __cpp_lib_ranges
+TEST_CASE("Printing/output streaming C++20 ranges",
+          "[output][ranges]")
+{
+    const std::vector<int> v { 1, 2, 3, 4 };
+
+    SECTION("detected as printable")
+    {
+        REQUIRE(traits::is_printable_as_container<
+                decltype(v | std::views::transform([](int i) { return i; }))>::value);
+        REQUIRE(traits::is_printable_as_container<
+                decltype(v | std::views::filter([](int i) { return i; }))>::value);
+        REQUIRE(traits::is_printable_as_container<
+                decltype(std::views::iota(0, 1))>::value);
+    }
+
+    SECTION("without changing detection of iterable or string types")
+    {
+        REQUIRE(!traits::is_printable_as_range<std::vector<int>>::value);
+        REQUIRE(!traits::is_printable_as_range<int[2]>::value);
+        REQUIRE(!traits::is_printable_as_container<std::string_view>::value);
+    }
+
+    SECTION("views iterable when const")
+    {
+        std::ostringstream oss;
+        oss << (v | std::views::transform([](int i) { return i * 2; }));
+        REQUIRE(oss.str() == "[2, 4, 6, 8]");
+    }
+
+    SECTION("views iterable only when non-const")
+    {
+        std::ostringstream oss;
+        oss << (v | std::views::filter([](int i) { return i % 2 == 0; }));
+        REQUIRE(oss.str() == "[2, 4]");
+    }
+
+    SECTION("unpopulated views")
+    {
+        std::ostringstream oss;
+        oss << std::views::iota(0, 0);
+        REQUIRE(oss.str() == "[]");
+    }
+
+    SECTION("nested views with string elements")
+    {
+        const std::vector<std::string> words { "a", "b\t" };
+        std::ostringstream oss;
+        oss << (std::views::iota(0, 2) | std::views::transform(
+                    [&words](int i) { return words | std::views::take(i + 1); }));
+        REQUIRE(oss.str() == "[[\"a\"], [\"a\", \"b\\t\"]]");
+    }
+}
+#endif  // __cpp_lib_ranges
+
+TEST_CASE("Printing contiguous containers of numeric types",
+          "[output]")
+{
+    std::ostringstream oss;
+
+    SECTION("detected as contiguous numeric containers")
+    {
+        REQUIRE(traits::is_contiguous_numeric_container<std::vector<int>>::value);
+        REQUIRE(traits::is_contiguous_numeric_container<std::array<double, 2>>::value);
+        REQUIRE(traits::is_contiguous_numeric_container<long[2]>::value);
+        REQUIRE(!traits::is_contiguous_numeric_container<std::vector<bool>>::value);
+        REQUIRE(!traits::is_contiguous_numeric_container<std::vector<char>>::value);
+        REQUIRE(!traits::is_contiguous_numeric_container<std::vector<uint8_t>>::value);
+        REQUIRE(!traits::is_contiguous_numeric_container<std::list<int>>::value);
+        REQUIRE(!traits::is_contiguous_numeric_container<std::string>::value);
+    }
+
+    SECTION("integral limits")
+    {
+        const std::vector<long long> v {
+            std::numeric_limits<long long>::min(), -1, 0,
+            std::numeric_limits<long long>::max() };
+        oss << v;
+        REQUIRE(oss.str() == "[-9223372036854775808, -1, 0, 9223372036854775807]");
+    }
+
+    SECTION("C arrays and std::array")
+    {
+        const short a[] { 1, -2, 3 };
+        const std::array<unsigned, 2> sa { { 4, 5 } };
+        oss << a << sa;
+        REQUIRE(oss.str() == "[1, -2, 3][4, 5]");
+    }
+
+    SECTION("more elements than fit in one block")
+    {
+        std::vector<int> v(1000);
+        std::iota(v.begin(), v.end(), -500);
+        std::string expected { "[" };
+        for (const auto i : v)
+            expected += std::to_string(i) + (i == 499 ? "]" : ", ");
+        oss << v;
+        REQUIRE(oss.str() == expected);
+    }
+
+    SECTION("floating point types with stream precision and floatfield")
+    {
+        const std::vector<double> v { 0.1, 1e20, -2.5, 1.0 / 3 };
+
+        SECTION("default")
+        {
+            oss << v;
+            REQUIRE(oss.str() == "[0.1, 1e+20, -2.5, 0.333333]");
+        }
+
+        SECTION("fixed")
+        {
+            oss << std::fixed << std::setprecision(2) << v;
+            REQUIRE(oss.str() ==
+                    "[0.10, 100000000000000000000.00, -2.50, 0.33]");
+        }
+
+        SECTION("scientific")
+        {
+            oss << std::scientific << std::setprecision(1) << v;
+            REQUIRE(oss.str() == "[1.0e-01, 1.0e+20, -2.5e+00, 3.3e-01]");
+        }
+
+        SECTION("fixed with formattings longer than block allows for")
+        {
+            const std::vector<double> big { 1e300, 1 };
+            std::ostringstream expected;
+            expected << std::fixed << std::setprecision(0)
+                     << '[' << big[0] << ", " << big[1] << ']';
+            oss << std::fixed << std::setprecision(0) << big;
+            REQUIRE(oss.str().size() > 300);
+            REQUIRE(oss.str() == expected.str());
+        }
+    }
+
+    SECTION("non-default integral flags")
+    {
+        const std::vector<int> v { 255, 16 };
+        oss << std::hex << std::showbase << v;
+        REQUIRE(oss.str() == "[0xff, 0x10]");
+    }
+
+    SECTION("wide streams")
+    {
+        std::wostringstream woss;
+        const std::vector<int> v { 1, -2 };
+        woss << v;
+        REQUIRE(woss.str() == L"[1, -2]");
+    }
+}
+
+TEST_CASE("Binary serialization of containers",
+          "[input][output][binary]")
+{
+    std::stringstream ss;
+
+    SECTION("byte layout")
+    {
+        const std::vector<uint16_t> v { 1, 0x0203 };
+        container_stream_io::binary::to_stream(ss, v);
+        REQUIRE(ss.str() == std::string("\x02\0\0\0\0\0\0\0" "\x01\0" "\x03\x02", 12));
+
+        ss.str("");
+        const std::pair<bool, std::string> p { true, "ab" };
+        container_stream_io::binary::to_stream(ss, p);
+        REQUIRE(ss.str() == std::string("\x01" "\x02\0\0\0\0\0\0\0" "ab", 11));
+    }
+
+    SECTION("round trip")
+    {
+        const std::map<std::string, std::vector<double>> m {
+            { "", {} }, { "a", { 1.5, -0.0, 1e300 } },
+            { std::string("\0\n", 2), { std::numeric_limits<double>::min() } } };
+        container_stream_io::binary::to_stream(ss, m);
+        std::map<std::string, std::vector<double>> m2;
+        container_stream_io::binary::from_stream(ss, m2);
+        REQUIRE(!ss.fail());
+        REQUIRE(m2 == m);
+
+        const std::tuple<int, std::u16string, std::forward_list<char32_t>, bool> t {
+            -7, u"été", { U'\U0001F600', U'x' }, false };
+        container_stream_io::binary::to_stream(ss, t);
+        std::tuple<int, std::u16string, std::forward_list<char32_t>, bool> t2;
+        container_stream_io::binary::from_stream(ss, t2);
+        REQUIRE(!ss.fail());
+        REQUIRE(t2 == t);
+
+        const std::array<std::set<long long>, 2> a { { { -1, 1 }, {} } };
+        container_stream_io::binary::to_stream(ss, a);
+        std::array<std::set<long long>, 2> a2;
+        container_stream_io::binary::from_stream(ss, a2);
+        REQUIRE(!ss.fail());
+        REQUIRE(a2 == a);
+
+        const char c[2][4] { "ab", "" };
+        container_stream_io::binary::to_stream(ss, c);
+        char c2[2][4] { "xyz", "xyz" };
+        container_stream_io::binary::from_stream(ss, c2);
+        REQUIRE(!ss.fail());
+        REQUIRE(std::string(c2[0]) == "ab");
+        REQUIRE(std::string(c2[1]) == "");
+    }
+
+    SECTION("long double stored in full")
+    {
+        using limits = std::numeric_limits<long double>;
+        const std::vector<long double> v {
+            1.0L / 3, -0.25L, -0.0L, limits::max(), limits::lowest(),
+            limits::denorm_min(), limits::infinity(), -limits::infinity() };
+        container_stream_io::binary::to_stream(ss, v);
+        REQUIRE(ss.str().size() == sizeof(std::uint64_t) + v.size() * 22);
+        std::vector<long double> v2;
+        container_stream_io::binary::from_stream(ss, v2);
+        REQUIRE(!ss.fail());
+        REQUIRE(v2 == v);
+        REQUIRE(std::signbit(v2[2]));
+
+        ss.str("");
+        ss.clear();
+        container_stream_io::binary::to_stream(
+            ss, std::vector<long double> { limits::quiet_NaN() });
+        container_stream_io::binary::from_stream(ss, v2);
+        REQUIRE(!ss.fail());
+        REQUIRE(v2.size() == 1);
+        REQUIRE(std::isnan(v2[0]));
+    }
+
+    SECTION("long double of a different precision fails")
+    {
+        container_stream_io::binary::to_stream(ss, std::vector<long double> { 1.5L });
+        auto s { ss.str() };
+        s[sizeof(std::uint64_t)] = char(std::numeric_limits<long double>::digits + 1);
+        std::stringstream ss2 { s };
+        std::vector<long double> v2 { 2.5L };
+        container_stream_io::binary::from_stream(ss2, v2);
+        REQUIRE(ss2.fail());
+        REQUIRE(v2 == std::vector<long double> { 2.5L });
+    }
+
+#ifdef __cpp_lib_ranges
+    SECTION("C++20 ranges without member size()")
+    {
+        const std::vector<int> v { 1, 2, 3, 4 };
+        std::stringstream expected;
+
+        // iterable only when non-const, counted through a copy
+        container_stream_io::binary::to_stream(
+            ss, v | std::views::filter([](int i) { return i % 2 == 0; }));
+        container_stream_io::binary::to_stream(expected, std::vector<int> { 2, 4 });
+        REQUIRE(ss.str() == expected.str());
+
+        // single pass, buffered before counting
+        ss.str("");
+        expected.str("");
+        std::istringstream iss("1 2 3");
+        container_stream_io::binary::to_stream(ss, std::views::istream<int>(iss));
+        container_stream_io::binary::to_stream(expected, std::vector<int> { 1, 2, 3 });
+        REQUIRE(ss.str() == expected.str());
+    }
+
+#endif  // __cpp_lib_ranges
+    SECTION("truncated serialization")
+    {
+        const std::vector<std::string> v { "abc", "def" };
+        container_stream_io::binary::to_stream(ss, v);
+        const auto bytes { ss.str() };
+        for (std::size_t i {}; i < bytes.size(); ++i)
+        {
+            std::istringstream iss(bytes.substr(0, i));
+            std::vector<std::string> v2 { "unchanged" };
+            container_stream_io::binary::from_stream(iss, v2);
+            REQUIRE(iss.fail());
+            REQUIRE(v2 == std::vector<std::string> { "unchanged" });
+        }
+    }
+
+    SECTION("std::array length mismatch")
+    {
+        const std::vector<int> v { 1, 2, 3 };
+        container_stream_io::binary::to_stream(ss, v);
+        std::array<int, 2> a { { 0, 0 } };
+        container_stream_io::binary::from_stream(ss, a);
+        REQUIRE(ss.fail());
+        REQUIRE(a == std::array<int, 2> { { 0, 0 } });
+    }
+
+    SECTION("invalid bool")
+    {
+        std::istringstream iss(std::string("\x01\0\0\0\0\0\0\0" "\x02", 9));
+        std::vector<bool> v;
+        container_stream_io::binary::from_stream(iss, v);
+        REQUIRE(iss.fail());
+    }
+}
+
+TEST_CASE("Binary serialization of containers with varint integers",
+          "[input][output][binary]")
+{
+    using container_stream_io::binary::varint;
+    using container_stream_io::binary::fixedint;
+
+    std::stringstream ss;
+    ss << varint;
+
+    SECTION("byte layout")
+    {
+        const std::vector<int64_t> v { -1, 64 };
+        container_stream_io::binary::to_stream(ss, v);
+        REQUIRE(ss.str() == "\x02" "\x01" "\x80\x01");
+
+        ss.str("");
+        const std::list<uint32_t> l { 300 };
+        container_stream_io::binary::to_stream(ss, l);
+        REQUIRE(ss.str() == "\x01" "\xac\x02");
+
+        ss.str("");
+        const std::pair<int8_t, std::string> p { -1, "ab" };
+        container_stream_io::binary::to_stream(ss, p);
+        REQUIRE(ss.str() == "\xff" "\x02" "ab");
+    }
+
+    SECTION("round trip")
+    {
+        const std::vector<int64_t> v {
+            0, -1, 1, 300, std::numeric_limits<int64_t>::min(),
+            std::numeric_limits<int64_t>::max() };
+        container_stream_io::binary::to_stream(ss, v);
+        std::vector<int64_t> v2;
+        container_stream_io::binary::from_stream(ss, v2);
+        REQUIRE(!ss.fail());
+        REQUIRE(v2 == v);
+
+        std::map<std::string, std::vector<unsigned short>> m;
+        for (unsigned short i {}; i < 100; ++i)
+            m["key" + std::to_string(i)].assign(i, i);
+        container_stream_io::binary::to_stream(ss, m);
+        std::map<std::string, std::vector<unsigned short>> m2;
+        container_stream_io::binary::from_stream(ss, m2);
+        REQUIRE(!ss.fail());
+        REQUIRE(m2 == m);
+
+        const std::set<std::pair<int, double>> s { { -5, 0.5 }, { 5, 1.5 } };
+        container_stream_io::binary::to_stream(ss, s);
+        std::set<std::pair<int, double>> s2;
+        container_stream_io::binary::from_stream(ss, s2);
+        REQUIRE(!ss.fail());
+        REQUIRE(s2 == s);
+    }
+
+    SECTION("smaller than fixed size integers")
+    {
+        std::vector<int64_t> v(1000);
+        std::iota(v.begin(), v.end(), -500);
+        container_stream_io::binary::to_stream(ss, v);
+        std::stringstream fixed_ss;
+        container_stream_io::binary::to_stream(fixed_ss << fixedint, v);
+        REQUIRE(ss.str().size() * 4 < fixed_ss.str().size());
+    }
+
+    SECTION("values out of range of element type")
+    {
+        std::istringstream iss("\x01" "\x80\x80\x04");  // 65536
+        iss >> varint;
+        std::vector<uint16_t> v;
+        container_stream_io::binary::from_stream(iss, v);
+        REQUIRE(iss.fail());
+
+        iss.clear();
+        iss.str("\x01" "\x80\x80\x80\x80\x80\x80\x80\x80\x80\x02");  // 2^64
+        std::vector<uint64_t> v2;
+        container_stream_io::binary::from_stream(iss, v2);
+        REQUIRE(iss.fail());
+    }
+
+    SECTION("truncated serialization")
+    {
+        const std::vector<std::vector<int>> v { { 1000, -1000 }, {} };
+        container_stream_io::binary::to_stream(ss, v);
+        const auto bytes { ss.str() };
+        for (std::size_t i {}; i < bytes.size(); ++i)
+        {
+            std::istringstream iss(bytes.substr(0, i));
+            iss >> varint;
+            std::vector<std::vector<int>> v2 { { 0 } };
+            container_stream_io::binary::from_stream(iss, v2);
+            REQUIRE(iss.fail());
+            REQUIRE(v2 == std::vector<std::vector<int>> { { 0 } });
+        }
+    }
+}
+
+TEST_CASE("Binary serialization of contiguous containers of arithmetic types",
+          "[input][output][binary]")
+{
+    std::stringstream ss;
+
+    SECTION("same layout as per element serialization")
+    {
+        const std::vector<std::vector<int32_t>> v { { -2, 0x01020304 } };
+        container_stream_io::binary::to_stream(ss, v);
+        REQUIRE(ss.str() == std::string(
+                    "\x01\0\0\0\0\0\0\0" "\x02\0\0\0\0\0\0\0"
+                    "\xfe\xff\xff\xff" "\x04\x03\x02\x01", 24));
+
+        ss.str("");
+        const std::vector<char> c { 'a', 'b' };
+        container_stream_io::binary::to_stream(
+            ss << container_stream_io::binary::varint, c);
+        REQUIRE(ss.str() == "\x02" "ab");
+    }
+
+    SECTION("round trip")
+    {
+        std::vector<double> v(100000);
+        std::iota(v.begin(), v.end(), -0.5);
+        container_stream_io::binary::to_stream(ss, v);
+        std::vector<double> v2;
+        container_stream_io::binary::from_stream(ss, v2);
+        REQUIRE(!ss.fail());
+        REQUIRE(v2 == v);
+
+        const std::map<std::string, std::array<float, 2>> m {
+            { "a", { { 1.5f, -2.5f } } }, { "b", { { 0.f, 1e10f } } } };
+        container_stream_io::binary::to_stream(ss, m);
+        std::map<std::string, std::array<float, 2>> m2;
+        container_stream_io::binary::from_stream(ss, m2);
+        REQUIRE(!ss.fail());
+        REQUIRE(m2 == m);
+
+        const uint16_t a[3] { 1, 2, 3 };
+        container_stream_io::binary::to_stream(ss, a);
+        uint16_t a2[3] {};
+        container_stream_io::binary::from_stream(ss, a2);
+        REQUIRE(!ss.fail());
+        REQUIRE(std::equal(std::begin(a), std::end(a), std::begin(a2)));
+    }
+
+    SECTION("std::array length mismatch")
+    {
+        const std::vector<double> v { 1, 2, 3 };
+        container_stream_io::binary::to_stream(ss, v);
+        std::array<double, 4> a { { 0, 0, 0, 0 } };
+        container_stream_io::binary::from_stream(ss, a);
+        REQUIRE(ss.fail());
+        REQUIRE(a == std::array<double, 4> { { 0, 0, 0, 0 } });
+    }
+
+    SECTION("length exceeding serialization")
+    {
+        // 2^40 elements declared, 2 present
+        std::istringstream iss(std::string("\0\0\0\0\0\x01\0\0", 8) +
+                               std::string(16, '\0'));
+        std::vector<double> v { 1 };
+        container_stream_io::binary::from_stream(iss, v);
+        REQUIRE(iss.fail());
+        REQUIRE(v == std::vector<double> { 1 });
+    }
+}
+
+TEST_CASE("Loading containers from memory mapped files",
+          "[input][memory]")
+{
+    const std::string path { "container_stream_io_load_file_test.txt" };
+    const auto write_file = [&path](const std::string& contents) {
+        std::ofstream ofs { path, std::ios_base::binary };
+        ofs << contents;
+    };
+
+    SECTION("parsing from a memory buffer")
+    {
+        const std::string s { "[1, 2, 3] trailing" };
+        container_stream_io::memory::input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        REQUIRE(container_stream_io::input::validate<std::vector<int>>(is));
+        is.seekg(0);
+        std::vector<int> v;
+        is >> v;
+        REQUIRE(!is.fail());
+        REQUIRE(v == std::vector<int> { 1, 2, 3 });
+        std::string rest;
+        is >> rest;
+        REQUIRE(rest == "trailing");
+        REQUIRE(is.tellg() == std::streampos(-1));  // eof
+    }
+
+    SECTION("well-formed file")
+    {
+        const std::map<std::string, std::vector<double>> m {
+            { "a", { 1.5, -2 } }, { "b c", {} } };
+        std::ostringstream oss;
+        oss << m;
+        write_file(oss.str());
+        REQUIRE(container_stream_io::memory::load_file<
+                std::map<std::string, std::vector<double>>>(path) == m);
+    }
+
+    SECTION("malformed file")
+    {
+        write_file("[1, 2");
+        REQUIRE_THROWS_AS(container_stream_io::memory::load_file<std::vector<int>>(path),
+                          std::ios_base::failure);
+        write_file("");
+        REQUIRE_THROWS_AS(container_stream_io::memory::load_file<std::vector<int>>(path),
+                          std::ios_base::failure);
+    }
+
+    SECTION("missing file")
+    {
+        std::remove(path.c_str());
+        REQUIRE_THROWS_AS(container_stream_io::memory::load_file<std::vector<int>>(path),
+                          std::ios_base::failure);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Navigating serializations in memory with cursors",
+          "[input][memory][cursor]")
+{
+    using container_stream_io::memory::cursor;
+
+    SECTION("finds value by key without decoding other elements")
+    {
+        using map_type = std::map<std::string, std::vector<int>>;
+        map_type m;
+        for (int i {}; i < 1000; ++i)
+            m["key " + std::to_string(i)] = std::vector<int>(std::size_t(i % 7), i);
+        m["\"tricky], key\""] = { 1 };
+        std::ostringstream oss;
+        oss << m;
+        const auto s { oss.str() };
+
+        cursor c { s.data(), s.size() };
+        REQUIRE(c.enter<map_type>());
+        std::vector<int> v;
+        std::size_t visited {};
+        while (c.next()) {
+            ++visited;
+            REQUIRE(c.enter<map_type::value_type>());
+            std::string key;
+            REQUIRE(c.next());
+            REQUIRE(c.get(key));
+            if (key == "key 500") {
+                REQUIRE(c.next());
+                REQUIRE(c.get(v));
+            }
+            REQUIRE(c.leave());
+        }
+        REQUIRE(c);
+        REQUIRE(c.depth() == 0);
+        REQUIRE(visited == m.size());
+        REQUIRE(v == m["key 500"]);
+        REQUIRE(c.position() == s.data() + s.size());
+    }
+
+    SECTION("skips nested containers and strings")
+    {
+        const std::string s {
+            "[(\"a, ]\", {'}'}), ([1], {}), (\"\\\"[\", {'x', 'y'})] tail" };
+        cursor c { s.data(), s.size() };
+        using element_type = std::pair<std::string, std::set<char>>;
+        REQUIRE(c.enter<std::vector<element_type>>());
+        REQUIRE(c.next());
+        REQUIRE(c.next());
+        REQUIRE(c.next());
+        element_type e;
+        REQUIRE(c.get(e));
+        REQUIRE(e == element_type { "\"[", { 'x', 'y' } });
+        REQUIRE_FALSE(c.next());
+        REQUIRE(c);
+        REQUIRE(std::string(c.position()) == " tail");
+    }
+
+    SECTION("decodes with formatting state of stream")
+    {
+        const std::wstring s { L"{L\"a\\tb\", L\"c\"}" };
+        container_stream_io::memory::basic_cursor<wchar_t> c { s.data(), s.size() };
+        c.stream() >> container_stream_io::strings::literalrepr;
+        REQUIRE(c.enter<std::set<std::wstring>>());
+        std::wstring first;
+        REQUIRE(c.next());
+        REQUIRE(c.get(first));
+        REQUIRE(first == L"a\tb");
+        REQUIRE(c.leave());
+    }
+
+    SECTION("skips root element")
+    {
+        const std::string s { "[[1, 2], [3]] [4]" };
+        cursor c { s.data(), s.size() };
+        c.skip();
+        REQUIRE(c);
+        REQUIRE(std::string(c.position()) == " [4]");
+    }
+
+    SECTION("fails on malformed serializations")
+    {
+        const std::string unterminated { "[1, 2" };
+        cursor c1 { unterminated.data(), unterminated.size() };
+        REQUIRE(c1.enter<std::vector<int>>());
+        REQUIRE(c1.next());
+        REQUIRE_FALSE(c1.leave());
+        REQUIRE_FALSE(c1);
+
+        const std::string wrong_prefix { "{1, 2}" };
+        cursor c2 { wrong_prefix.data(), wrong_prefix.size() };
+        REQUIRE_FALSE(c2.enter<std::vector<int>>());
+        REQUIRE_FALSE(c2.next());
+
+        const std::string wrong_separator { "[1; 2]" };
+        cursor c3 { wrong_separator.data(), wrong_separator.size() };
+        REQUIRE(c3.enter<std::vector<int>>());
+        int i {};
+        REQUIRE(c3.next());
+        REQUIRE(c3.get(i));
+        REQUIRE(i == 1);
+        REQUIRE_FALSE(c3.next());
+        REQUIRE(c3.stream().fail());
+    }
+}
+
+TEST_CASE("Saving containers to files",
+          "[output][memory]")
+{
+    const std::string path { "container_stream_io_save_file_test.txt" };
+    const auto read_file = [&path]() {
+        std::ifstream ifs { path, std::ios_base::binary };
+        return std::string { std::istreambuf_iterator<char>(ifs),
+                             std::istreambuf_iterator<char>() };
+    };
+
+    SECTION("same serialization as operator<<")
+    {
+        const std::vector<std::pair<int, std::string>> v { { 1, "a" }, { 2, "b c" } };
+        std::ostringstream oss;
+        oss << v;
+        container_stream_io::memory::save_file(path, v);
+        REQUIRE(read_file() == oss.str());
+
+        // previous contents replaced
+        container_stream_io::memory::save_file(path, std::vector<int>{});
+        REQUIRE(read_file() == "[]");
+    }
+
+    SECTION("serializations larger than a block")
+    {
+        std::map<std::string, std::vector<int>> m;
+        for (int i {}; i < 1000; ++i)
+            m[std::string(1000, 'k') + std::to_string(i)].assign(100, i);
+        container_stream_io::memory::save_file(path, m);
+        REQUIRE(container_stream_io::memory::load_file<
+                std::map<std::string, std::vector<int>>>(path) == m);
+    }
+
+    SECTION("unwritable path")
+    {
+        REQUIRE_THROWS_AS(container_stream_io::memory::save_file(
+                              "no_such_directory/" + path, std::vector<int>{ 1 }),
+                          std::ios_base::failure);
+    }
+
+    std::remove(path.c_str());
+}
+
+namespace {
+
+template <typename ContainerType>
+void require_same_as_sequential(const ContainerType& container)
+{
+    std::ostringstream oss, poss;
+    oss << std::setprecision(3) << container_stream_io::strings::quotedrepr << container;
+    poss << std::setprecision(3) << container_stream_io::strings::quotedrepr;
+    container_stream_io::parallel::to_stream(poss, container, 4);
+    REQUIRE(!poss.fail());
+    REQUIRE(poss.str() == oss.str());
+}
+
+}  // namespace
+
+TEST_CASE("Printing large containers in parallel",
+          "[output][parallel]")
+{
+    const auto chunk_size = container_stream_io::parallel::min_chunk_size;
+
+    SECTION("contiguous numeric containers")
+    {
+        std::vector<double> v(chunk_size * 4 + 3);
+        std::iota(v.begin(), v.end(), 0.25);
+        require_same_as_sequential(v);
+    }
+
+    SECTION("other random access containers")
+    {
+        std::deque<std::string> d(chunk_size * 3, "a\tb");
+        d.front() = "first";
+        d.back() = "last";
+        require_same_as_sequential(d);
+
+        const std::vector<std::pair<char, int>> v(chunk_size * 2 + 1, { 'c', 1 });
+        require_same_as_sequential(v);
+    }
+
+    SECTION("small containers")
+    {
+        require_same_as_sequential(std::vector<int> { 1, 2, 3 });
+        require_same_as_sequential(std::vector<int> {});
+    }
+
+    SECTION("wide streams")
+    {
+        const std::vector<int> v(chunk_size * 2, 7);
+        std::wostringstream woss, wposs;
+        woss << v;
+        container_stream_io::parallel::to_stream(wposs, v, 2);
+        REQUIRE(wposs.str() == woss.str());
+    }
+}
+
+TEST_CASE("Parsing large containers in parallel",
+          "[input][parallel]")
+{
+    using container_stream_io::memory::input_buffer;
+
+    SECTION("numeric elements")
+    {
+        std::vector<int> v(100000);
+        std::iota(v.begin(), v.end(), -50000);
+        std::ostringstream oss;
+        oss << v << " trailing";
+        const auto s { oss.str() };
+        input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        std::vector<int> v2;
+        container_stream_io::parallel::from_stream(is, v2, 4);
+        REQUIRE(!is.fail());
+        REQUIRE(v2 == v);
+        std::string rest;
+        is >> rest;
+        REQUIRE(rest == "trailing");
+    }
+
+    SECTION("chunks of similar length")
+    {
+        std::vector<int> v(200000);
+        std::iota(v.begin(), v.end(), 100000);
+        std::ostringstream oss;
+        oss << v;
+        const auto s { oss.str() };
+        const char* first { s.data() + 1 };  // after prefix
+        const char* last { s.data() + s.size() };
+        std::vector<const char*> boundaries;
+        const auto suffix { container_stream_io::parallel::detail::split_elements(
+            first, last, ", ", 4, boundaries) };
+        REQUIRE(suffix == last - 1);
+        REQUIRE(boundaries.size() == 3);
+        boundaries.insert(boundaries.begin(), first);
+        boundaries.push_back(suffix);
+        const auto length { std::size_t(suffix - first) };
+        for (std::size_t i { 1 }; i < boundaries.size(); ++i) {
+            const auto chunk_length { std::size_t(boundaries[i] - boundaries[i - 1]) };
+            REQUIRE(chunk_length > length / 5);
+            REQUIRE(chunk_length < length / 3);
+        }
+    }
+
+    SECTION("strings with delimiters and escapes")
+    {
+        std::deque<std::string> d;
+        for (int i {}; i < 20000; ++i)
+            d.push_back(i % 3 == 0 ? "a, \"b\"] [c" : i % 3 == 1 ? "\\'(" : "");
+        std::ostringstream oss;
+        oss << container_stream_io::strings::quotedrepr << d;
+        const auto s { oss.str() };
+        input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        is >> container_stream_io::strings::quotedrepr;
+        std::deque<std::string> d2;
+        container_stream_io::parallel::from_stream(is, d2, 3);
+        REQUIRE(!is.fail());
+        REQUIRE(d2 == d);
+    }
+
+    SECTION("nested containers")
+    {
+        std::list<std::pair<char, std::vector<int>>> l;
+        for (int i {}; i < 20000; ++i)
+            l.emplace_back(i % 2 ? ']' : ',', std::vector<int>(i % 5, i));
+        std::ostringstream oss;
+        oss << l;
+        const auto s { oss.str() };
+        input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        std::list<std::pair<char, std::vector<int>>> l2;
+        container_stream_io::parallel::from_stream(is, l2, 8);
+        REQUIRE(!is.fail());
+        REQUIRE(l2 == l);
+    }
+
+    SECTION("malformed serializations")
+    {
+        std::vector<int> v(100000, 1);
+        std::ostringstream oss;
+        oss << v;
+        auto s { oss.str() };
+        s[s.size() / 2] = 'x';
+        input_buffer buffer { s.data(), s.size() };
+        std::istream is { &buffer };
+        std::vector<int> v2 { 0 };
+        container_stream_io::parallel::from_stream(is, v2, 4);
+        REQUIRE(is.fail());
+        REQUIRE(v2 == std::vector<int> { 0 });
+    }
+
+    SECTION("truncated serializations leave stream state as with operator>>")
+    {
+        std::vector<long> v(100000, 123456789L);
+        std::ostringstream oss;
+        oss << v;
+        const auto full { oss.str() };
+        REQUIRE(full.size() > 2 * container_stream_io::parallel::min_chunk_length);
+        // cut after an element, after a separator, and within an element
+        for (const std::size_t cut : { std::size_t(1), std::size_t(3), std::size_t(6) }) {
+            const auto s { full.substr(0, full.size() - cut) };
+            input_buffer buffer { s.data(), s.size() };
+            std::istream is { &buffer };
+            std::vector<long> v2 { 0 };
+            container_stream_io::parallel::from_stream(is, v2, 4);
+            std::istringstream iss { s };
+            std::vector<long> v3 { 0 };
+            iss >> v3;
+            REQUIRE(is.rdstate() == iss.rdstate());
+            REQUIRE(v2 == v3);
+        }
+    }
+
+    SECTION("sequential fallback")
+    {
+        std::istringstream iss { "[1, 2, 3]" };
+        std::vector<int> v;
+        container_stream_io::parallel::from_stream(iss, v, 4);
+        REQUIRE(!iss.fail());
+        REQUIRE(v == std::vector<int> { 1, 2, 3 });
+
+        std::istringstream set_iss { "{1, 2, 3}" };
+        std::set<int> st;
+        container_stream_io::parallel::from_stream(set_iss, st, 4);
+        REQUIRE(!set_iss.fail());
+        REQUIRE(st == std::set<int> { 1, 2, 3 });
+    }
+}